@@ -0,0 +1,533 @@
+﻿#include "Fitness.h"
+#include "GA.h"
+#include "GraphGenerator.h"
+#include "GraphPartitioner.h"
+#include "GraphReorder.h"
+#include "GraphReplicas.h"
+#include "HugePages.h"
+#include "Pareto.h"
+#include "PathUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+// Random point-to-point BFS queries from `threads` workers, each bound to a
+// NUMA node round-robin and reading that node's replica.
+static double runQueries(const GraphReplicas& replicas, int threads, int queries) {
+    std::vector<std::thread> workers;
+    auto t0 = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            Numa::bindThread(t % Numa::nodeCount());
+            const Graph& g = replicas.local();
+            std::mt19937 rng((unsigned)t + 1);
+            size_t sink = 0;
+            for (int q = 0; q < queries; ++q) {
+                int a = (int)(rng() % (unsigned)g.nodeCount());
+                int b = (int)(rng() % (unsigned)g.nodeCount());
+                sink += PathUtils::bfsPath(g, a, b).size();
+            }
+            if (sink == (size_t)-1) std::cout << "";
+        });
+    }
+    for (auto& w : workers) w.join();
+    return seconds(t0, Clock::now());
+}
+
+// optnet_bench memory [nodes] [threads] [queries]
+static int benchMemory(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 4000;
+    int threads = argc > 3 ? std::stoi(argv[3]) : (int)std::max(1u, std::thread::hardware_concurrency());
+    int queries = argc > 4 ? std::stoi(argv[4]) : 200;
+
+    // adjacency backends, counted over the whole graph; the varint rows are
+    // built without the CSR and must equal the CSR's encoding. A varint
+    // graph keeps no hop cost columns; OPTNET_COMPACT_GRAPH adds float weights.
+    // For scale: the edge list alone, as Edge values, is 24 bytes per edge.
+    {
+        Graph g = GraphGenerator().generate(nodes);
+        GraphReorder::apply(g, NodeOrder::RCM);
+        Graph csr = g;
+        for (int packed = 0; packed < 2; ++packed) {
+            auto t0 = Clock::now();
+            g.buildAdjacency(0, packed == 1);
+            double s = seconds(t0, Clock::now());
+            std::cout << "[BENCH] adjacency=" << (packed ? "varint" : "csr")
+                << " edges=" << g.edges.size()
+                << " build=" << s << " s"
+                << " weights=" << (sizeof(weight_t) == sizeof(float) ? "float" : "double")
+                << " hop_columns=" << (g.hasHopColumns() ? "yes" : "no")
+                << " adj_bytes=" << g.adjacencyBytes()
+                << " graph_bytes=" << g.bytes()
+                << " bytes/edge=" << (double)g.bytes() / (double)g.edges.size() << "\n";
+        }
+
+        csr.compressAdjacency();
+        size_t differ = 0;
+        for (int v = 0; v < g.nodeCount(); ++v) {
+            if (!std::equal(g.packed->rowBegin(v), g.packed->rowEnd(v), csr.packed->rowBegin(v), csr.packed->rowEnd(v))) ++differ;
+        }
+        std::cout << "[BENCH] varint rows differing from the CSR encoding: " << differ << "\n";
+        if (differ) return 1;
+    }
+
+    std::cout << "[BENCH] NUMA nodes=" << Numa::nodeCount() << " threads=" << threads
+        << " queries/thread=" << queries << "\n";
+
+    const HugePageMode modes[] = { HugePageMode::Off, HugePageMode::Transparent };
+    const char* names[] = { "off", "thp" };
+
+    for (int m = 0; m < 2; ++m) {
+        HugePages::setMode(modes[m]);
+
+        GraphGenerator gen;
+        Graph g = gen.generate(nodes);
+        GraphReorder::apply(g, NodeOrder::RCM);
+        auto shared = std::make_shared<const Graph>(g.clone());
+        g = Graph();
+
+        for (int replicate = 0; replicate < 2; ++replicate) {
+            GraphReplicas replicas(shared, replicate == 1);
+            double s = runQueries(replicas, threads, queries);
+            std::cout << "[BENCH] huge_pages=" << names[m]
+                << " replicas=" << replicas.count()
+                << " huge_bytes=" << HugePages::hugeBytes()
+                << " time=" << s << " s"
+                << " qps=" << (threads * queries) / s << "\n";
+        }
+    }
+    return 0;
+}
+
+// optnet_bench fitness [nodes] [paths] [rounds]
+// Scores random paths with the precomputed hop costs, with the formula on
+// the raw weight columns and as edge genomes; the scores must match bit for bit.
+static int benchFitness(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 2000;
+    int paths = argc > 3 ? std::stoi(argv[3]) : 2000;
+    int rounds = argc > 4 ? std::stoi(argv[4]) : 50;
+
+    GraphGenerator gen;
+    Graph g = gen.generate(nodes);
+
+    std::vector<std::vector<int>> population;
+    while ((int)population.size() < paths) {
+        auto p = PathUtils::randomPath(g, 60);
+        if (!p.empty()) population.push_back(std::move(p));
+    }
+
+    std::vector<std::vector<int>> genomes(population.size());
+    for (size_t i = 0; i < population.size(); ++i) PathUtils::toEdges(g, population[i], genomes[i]);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < population.size(); ++i) {
+        const auto& p = population[i];
+        double s = Fitness::evaluate(g, p);
+        if (s != Fitness::evaluateExact(g, p)) ++mismatches;
+        else if (s != Fitness::evaluate(g, p.front(), genomes[i])) ++mismatches;
+    }
+
+    double sink = 0.0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& p : population) sink += Fitness::evaluateExact(g, p);
+    auto t1 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& p : population) sink += Fitness::evaluate(g, p);
+    auto t2 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& e : genomes) sink += Fitness::evaluate(g, g.start_node, e);
+    auto t3 = Clock::now();
+
+    double evals = (double)rounds * paths;
+    std::cout << "[BENCH] paths=" << paths << " mismatches=" << mismatches
+        << " formula=" << evals / seconds(t0, t1) << " evals/s"
+        << " precomputed=" << evals / seconds(t1, t2) << " evals/s"
+        << " edges=" << evals / seconds(t2, t3) << " evals/s"
+        << (sink == 0.0 ? " " : "") << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+// optnet_bench batch [nodes] [paths] [rounds]
+// Scores a population of edge genomes path by path and with every batch
+// kernel the CPU runs; the batch scores must match bit for bit.
+static int benchBatch(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 2000;
+    int paths = argc > 3 ? std::stoi(argv[3]) : 4000;
+    int rounds = argc > 4 ? std::stoi(argv[4]) : 50;
+
+    GraphGenerator gen;
+    Graph g = gen.generate(nodes);
+
+    std::vector<std::vector<int>> genomes;
+    PathBatch batch;
+    std::vector<int> genome;
+    while ((int)batch.size() < paths) {
+        auto p = PathUtils::randomPath(g, 60);
+        if (p.empty() || !PathUtils::toEdges(g, p, genome)) continue;
+        batch.add(p.front(), genome);
+        genomes.push_back(genome);
+    }
+
+    double evals = (double)rounds * paths;
+    double sink = 0.0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const auto& e : genomes) sink += Fitness::evaluate(g, g.start_node, e);
+    double single = evals / seconds(t0, Clock::now());
+    std::cout << "[BENCH] paths=" << paths << " edges=" << batch.edges.size()
+        << " single=" << single << " evals/s\n";
+
+    const std::pair<BatchKernel, const char*> kernels[] = {
+        { BatchKernel::Scalar, "scalar" }, { BatchKernel::AVX2, "avx2" }, { BatchKernel::AVX512, "avx512" }
+    };
+    size_t mismatches = 0;
+    std::vector<double> scores;
+    for (const auto& [kernel, name] : kernels) {
+        if ((int)kernel > (int)Fitness::bestBatchKernel()) break;
+
+        Fitness::evaluateBatch(g, batch, scores, kernel);
+        size_t bad = 0;
+        for (size_t i = 0; i < genomes.size(); ++i) {
+            if (scores[i] != Fitness::evaluate(g, g.start_node, genomes[i])) ++bad;
+        }
+        mismatches += bad;
+
+        auto t1 = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            Fitness::evaluateBatch(g, batch, scores, kernel);
+            sink += scores[0];
+        }
+        double rate = evals / seconds(t1, Clock::now());
+        std::cout << "[BENCH] " << name << " mismatches=" << bad << " " << rate << " evals/s"
+            << " speedup=" << rate / single << "x" << (sink == 0.0 ? " " : "") << "\n";
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+// optnet_bench bounded [nodes] [paths] [keep%]
+// Scores random walks in full and against a cutoff that only keep% of them
+// meet, as late in a run. No walk within the cutoff may be rejected, and
+// the ones kept must score as in full.
+static int benchBounded(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 2000;
+    int paths = argc > 3 ? std::stoi(argv[3]) : 4000;
+    double keep = argc > 4 ? std::stod(argv[4]) : 10.0;
+
+    GraphGenerator gen;
+    Graph g = gen.generate(nodes);
+
+    std::vector<std::vector<int>> genomes;
+    std::vector<int> genome;
+    while ((int)genomes.size() < paths) {
+        auto p = PathUtils::randomPath(g, 60);
+        if (p.empty() || !PathUtils::toEdges(g, p, genome)) continue;
+        genomes.push_back(genome);
+    }
+
+    const int rounds = 10;
+    std::vector<double> full(genomes.size());
+    for (size_t i = 0; i < genomes.size(); ++i) full[i] = Fitness::evaluate(g, g.start_node, genomes[i]);
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (size_t i = 0; i < genomes.size(); ++i) full[i] = Fitness::evaluate(g, g.start_node, genomes[i]);
+    auto t1 = Clock::now();
+
+    std::vector<double> sorted = full;
+    std::sort(sorted.begin(), sorted.end());
+    size_t at = std::min(sorted.size() - 1, (size_t)(keep / 100.0 * (double)sorted.size()));
+    double cutoff = sorted[at];
+
+    std::vector<double> bounded(genomes.size());
+    auto t2 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (size_t i = 0; i < genomes.size(); ++i)
+            bounded[i] = Fitness::evaluateBounded(g, g.start_node, genomes[i], cutoff);
+    auto t3 = Clock::now();
+
+    size_t rejected = 0;
+    size_t wrong = 0;
+    for (size_t i = 0; i < genomes.size(); ++i) {
+        if (bounded[i] == Fitness::REJECTED) {
+            ++rejected;
+            if (full[i] <= cutoff) ++wrong;
+        }
+        else if (bounded[i] != full[i]) ++wrong;
+    }
+
+    std::cout << "[BENCH] paths=" << paths << " cutoff=" << cutoff
+        << " full=" << (double)rounds * paths / seconds(t0, t1) << " evals/s"
+        << " bounded=" << (double)rounds * paths / seconds(t2, t3) << " evals/s"
+        << " rejected=" << rejected << " wrong=" << wrong << "\n";
+    return wrong == 0 ? 0 : 1;
+}
+
+// optnet_bench evolve [nodes] [runs]
+// Full GA runs on one generated graph with bounded fitness off and on. A
+// bounded run replaces children that can't beat the worst of their parents'
+// generation by copies from it, so it is a different (truncation-like)
+// selection; the final fitness shows what that costs or gains.
+static int benchEvolve(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 2000;
+    int runs = argc > 3 ? std::stoi(argv[3]) : 5;
+    if (runs < 1) throw std::runtime_error("runs must be >= 1");
+
+    GraphGenerator gen;
+    Graph g = gen.generate(nodes);
+
+    for (bool bounded : { false, true }) {
+        double sum = 0.0;
+        double best = 1e18;
+        double worst = 0.0;
+        auto t0 = Clock::now();
+        for (int r = 0; r < runs; ++r) {
+            GA ga(g);
+            ga.setBoundedFitness(bounded);
+            double f = ga.run().fitness;
+            sum += f;
+            best = std::min(best, f);
+            worst = std::max(worst, f);
+        }
+        auto t1 = Clock::now();
+        std::cout << "[BENCH] bounded=" << (bounded ? "on" : "off") << " runs=" << runs
+            << " fitness mean=" << sum / runs << " best=" << best << " worst=" << worst
+            << " time=" << seconds(t0, t1) / runs * 1e3 << " ms/run\n";
+    }
+    return 0;
+}
+
+// optnet_bench pareto [points] [objectives]
+// Non-dominated sorting of random points, half of them on a coarse grid so
+// there are ties and duplicates, against Deb's O(M N^2) sort.
+static int benchPareto(int argc, char** argv) {
+    int points = argc > 2 ? std::stoi(argv[2]) : 4000;
+    int m = argc > 3 ? std::stoi(argv[3]) : 3;
+    if (points < 1 || m < 1) throw std::runtime_error("points and objectives must be >= 1");
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> values((size_t)points * (size_t)m);
+    for (size_t i = 0; i < values.size(); ++i) {
+        double v = unit(rng);
+        values[i] = (i / (size_t)m) % 2 ? std::floor(v * 8.0) : v;
+    }
+
+    auto t0 = Clock::now();
+    std::vector<int> fast = ParetoSort::rank(values, (size_t)m);
+    auto t1 = Clock::now();
+    std::vector<int> naive = ParetoSort::rankNaive(values, (size_t)m);
+    auto t2 = Clock::now();
+    std::vector<double> crowd = ParetoSort::crowding(values, (size_t)m, fast);
+    auto t3 = Clock::now();
+
+    size_t wrong = 0;
+    for (size_t i = 0; i < fast.size(); ++i) {
+        if (fast[i] != naive[i]) ++wrong;
+    }
+    std::cout << "[BENCH] points=" << points << " objectives=" << m
+        << " fronts=" << *std::max_element(fast.begin(), fast.end()) + 1
+        << " sort=" << seconds(t0, t1) * 1e3 << " ms naive=" << seconds(t1, t2) * 1e3 << " ms"
+        << " crowding=" << seconds(t2, t3) * 1e3 << " ms mismatches=" << wrong << "\n";
+    return wrong == 0 ? 0 : 1;
+}
+
+// optnet_bench partition [side] [parts] [threads]
+// k-way partition of a side x side grid. Reports the cut against the
+// side * (rows + cols - 2) of a straight block layout and the largest part
+// against n / parts.
+static int benchPartition(int argc, char** argv) {
+    int side = argc > 2 ? std::stoi(argv[2]) : 1000;
+    int parts = argc > 3 ? std::stoi(argv[3]) : 8;
+    int threads = argc > 4 ? std::stoi(argv[4]) : 0;
+    if (side < 2 || parts < 2) throw std::runtime_error("side and parts must be >= 2");
+
+    Graph g;
+    for (int i = 0; i < side * side; ++i) {
+        Node node;
+        node.id = i;
+        g.nodes.push_back(node);
+    }
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side) g.edges.push_back({ v, v + 1, 1.0, 1.0 });
+            if (r + 1 < side) g.edges.push_back({ v, v + side, 1.0, 1.0 });
+        }
+    }
+    g.end_node = side * side - 1;
+    g.buildAdjacency();
+
+    PartitionOptions options;
+    options.parts = parts;
+    options.threads = threads;
+    auto t0 = Clock::now();
+    Partition p = GraphPartitioner::partition(g, options);
+    auto t1 = Clock::now();
+
+    std::vector<int> size((size_t)parts, 0);
+    for (int q : p.part) ++size[(size_t)q];
+    int largest = *std::max_element(size.begin(), size.end());
+    double ideal = (double)g.nodeCount() / parts;
+    int rows = std::max(1, (int)std::lround(std::sqrt((double)parts)));
+    int cols = (parts + rows - 1) / rows;
+    bool balanced = largest <= (1.0 + options.imbalance) * ideal + std::ceil(std::log2((double)parts));
+
+    std::cout << "[BENCH] grid=" << side << "x" << side << " parts=" << parts
+        << " cut=" << p.cut << " blocks=" << (long long)side * (rows + cols - 2)
+        << " largest=" << largest << " (" << largest / ideal << "x ideal)"
+        << " time=" << seconds(t0, t1) * 1e3 << " ms\n";
+    return balanced ? 0 : 1;
+}
+
+// Batch scoring rate under one objective
+template <class Objective>
+static void benchObjective(const Graph& g, const PathBatch& batch, int rounds, const char* name) {
+    std::vector<double> scores;
+    double sink = 0.0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        BasicFitness<Objective>::evaluateBatch(g, batch, scores);
+        sink += scores[0];
+    }
+    double rate = (double)rounds * (double)batch.size() / seconds(t0, Clock::now());
+    std::cout << "[BENCH] " << name << " needs=" << Objective::needs << " " << rate << " evals/s"
+        << (sink == 0.0 ? " " : "") << "\n";
+}
+
+// optnet_bench objectives [nodes] [paths] [rounds]
+// Batch scoring under every prebuilt objective: the sums an objective
+// doesn't read are compiled out of its kernels.
+static int benchObjectives(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 2000;
+    int paths = argc > 3 ? std::stoi(argv[3]) : 4000;
+    int rounds = argc > 4 ? std::stoi(argv[4]) : 50;
+
+    GraphGenerator gen;
+    Graph g = gen.generate(nodes);
+
+    PathBatch batch;
+    std::vector<int> genome;
+    while ((int)batch.size() < paths) {
+        auto p = PathUtils::randomPath(g, 60);
+        if (p.empty() || !PathUtils::toEdges(g, p, genome)) continue;
+        batch.add(p.front(), genome);
+    }
+
+#define OPTNET_BENCH_OBJECTIVE(Objective, name) benchObjective<Objective>(g, batch, rounds, name);
+    OPTNET_OBJECTIVES(OPTNET_BENCH_OBJECTIVE)
+#undef OPTNET_BENCH_OBJECTIVE
+    return 0;
+}
+
+// optnet_bench delta [nodes] [hops] [children]
+// Builds crossover and mutation children of long random walks and scores
+// them from scratch and from their parents' running sums.
+static int benchDelta(int argc, char** argv) {
+    int nodes = argc > 2 ? std::stoi(argv[2]) : 2000;
+    int hops = argc > 3 ? std::stoi(argv[3]) : 400;
+    int children = argc > 4 ? std::stoi(argv[4]) : 4000;
+
+    GraphGenerator gen;
+    Graph g = gen.generate(nodes);
+    std::mt19937 rng(1);
+
+    std::vector<std::vector<int>> parents(64);
+    std::vector<PathSums> sums(parents.size());
+    for (size_t p = 0; p < parents.size(); ++p) {
+        int v = g.start_node;
+        for (int k = 0; k < hops && g.degree(v) > 0; ++k) {
+            NeighborCursor c = g.cursor(v);
+            for (int s = (int)(rng() % (unsigned)g.degree(v)); s >= 0; --s) c.next();
+            parents[p].push_back(c.edge);
+            v = c.target;
+        }
+        PathUtils::repairToEnd(g, v, parents[p]);
+        Fitness::walkSums(g, g.start_node, parents[p], sums[p]);
+    }
+
+    // child = head's first `keep` edges + middle + tail's edges from `from`
+    struct Child { size_t head, keep, tail, from; std::vector<int> middle, edges; };
+    std::vector<Child> brood;
+    while ((int)brood.size() < children) {
+        Child c{ rng() % parents.size(), 0, parents.size(), 0, {}, {} };
+        const PathSums& a = sums[c.head];
+        c.keep = 1 + rng() % (a.nodes.size() - 2);
+        if (rng() % 2) {
+            // crossover at the first node of b that a has at keep
+            c.tail = rng() % parents.size();
+            const PathSums& b = sums[c.tail];
+            auto it = std::find(b.nodes.begin() + 1, b.nodes.end() - 1, a.nodes[c.keep]);
+            if (it == b.nodes.end() - 1) continue;
+            c.from = (size_t)(it - b.nodes.begin());
+        }
+        else if (!PathUtils::repairToEnd(g, a.nodes[c.keep], c.middle)) continue;
+
+        c.edges.assign(parents[c.head].begin(), parents[c.head].begin() + (std::ptrdiff_t)c.keep);
+        c.edges.insert(c.edges.end(), c.middle.begin(), c.middle.end());
+        if (c.tail < parents.size())
+            c.edges.insert(c.edges.end(), parents[c.tail].begin() + (std::ptrdiff_t)c.from, parents[c.tail].end());
+        brood.push_back(std::move(c));
+    }
+
+    std::vector<double> scratch(brood.size());
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < brood.size(); ++i) scratch[i] = Fitness::evaluate(g, g.start_node, brood[i].edges);
+    auto t1 = Clock::now();
+    double worst = 0.0;
+    PathSums out;
+    for (size_t i = 0; i < brood.size(); ++i) {
+        const Child& c = brood[i];
+        const PathSums* tail = c.tail < parents.size() ? &sums[c.tail] : nullptr;
+        Fitness::spliceSums(g, sums[c.head], c.keep, c.middle, tail, c.from, out);
+        double s = Fitness::evaluate(g, out);
+        worst = std::max(worst, std::abs(s - scratch[i]) / std::abs(scratch[i]));
+    }
+    auto t2 = Clock::now();
+
+    double hopsTotal = 0.0;
+    for (const Child& c : brood) hopsTotal += (double)c.edges.size();
+    std::cout << "[BENCH] children=" << brood.size() << " avg_hops=" << hopsTotal / (double)brood.size()
+        << " scratch=" << (double)brood.size() / seconds(t0, t1) << " evals/s"
+        << " delta=" << (double)brood.size() / seconds(t1, t2) << " evals/s"
+        << " worst_rel_diff=" << worst << "\n";
+    return worst < 1e-9 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    if (mode == "memory") return benchMemory(argc, argv);
+    if (mode == "fitness") return benchFitness(argc, argv);
+    if (mode == "batch") return benchBatch(argc, argv);
+    if (mode == "delta") return benchDelta(argc, argv);
+    if (mode == "objectives") return benchObjectives(argc, argv);
+    if (mode == "bounded") return benchBounded(argc, argv);
+    if (mode == "evolve") return benchEvolve(argc, argv);
+    if (mode == "pareto") return benchPareto(argc, argv);
+    if (mode == "partition") return benchPartition(argc, argv);
+
+    std::cerr << "usage: optnet_bench memory [nodes] [threads] [queries]\n"
+        << "       optnet_bench fitness [nodes] [paths] [rounds]\n"
+        << "       optnet_bench batch [nodes] [paths] [rounds]\n"
+        << "       optnet_bench delta [nodes] [hops] [children]\n"
+        << "       optnet_bench objectives [nodes] [paths] [rounds]\n"
+        << "       optnet_bench bounded [nodes] [paths] [keep%]\n"
+        << "       optnet_bench evolve [nodes] [runs]\n"
+        << "       optnet_bench pareto [points] [objectives]\n"
+        << "       optnet_bench partition [side] [parts] [threads]\n";
+    return 1;
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+#include "HugePages.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// std::allocator replacement that returns Align-byte aligned blocks
+// (cache line by default), so graph columns start on a vector boundary.
+// Large blocks may be backed by huge pages, see HugePages.h.
+template <class T, std::size_t Align = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() noexcept = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(HugePages::allocate(n * sizeof(T), Align));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        HugePages::deallocate(p, n * sizeof(T), Align);
+    }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+};
+
+template <class T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
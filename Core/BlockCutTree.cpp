@@ -0,0 +1,130 @@
+﻿#include "BlockCutTree.h"
+#include <algorithm>
+
+namespace {
+    struct Frame {
+        int v;
+        int parentEdge;
+        NeighborCursor it;
+    };
+}
+
+BlockCutTree BlockCutTree::build(const Graph& g, int root, const std::vector<char>* keep) {
+    const size_t n = (size_t)g.nodeCount();
+    BlockCutTree t;
+    t.cut.assign(n, 0);
+    t.home.assign(n, -1);
+    if (!g.hasNode(root) || (keep && !(*keep)[(size_t)root])) return t;
+
+    auto visible = [&](int v) { return !keep || (*keep)[(size_t)v]; };
+
+    std::vector<int> disc(n, -1);
+    std::vector<int> low(n, 0);
+    std::vector<int> edgeStack;
+    std::vector<Frame> stack;
+    std::vector<int> inBlock(n, -1);   // last block a node was added to
+    int clock = 0;
+
+    // pops the edges of the block closed by tree edge `edge`
+    auto closeBlock = [&](int edge) {
+        int b = t.blockCount();
+        size_t first = t.blockNodes.size();
+        while (true) {
+            int e = edgeStack.back();
+            edgeStack.pop_back();
+            for (int v : { g.edges.node_a[(size_t)e], g.edges.node_b[(size_t)e] }) {
+                if (inBlock[(size_t)v] == b) continue;
+                inBlock[(size_t)v] = b;
+                if (t.home[(size_t)v] >= 0) t.cut[(size_t)v] = 1;
+                else t.home[(size_t)v] = b;
+                t.blockNodes.push_back(v);
+            }
+            if (e == edge) break;
+        }
+        std::sort(t.blockNodes.begin() + (std::ptrdiff_t)first, t.blockNodes.end());
+        t.blockOffsets.push_back((int)t.blockNodes.size());
+    };
+
+    disc[(size_t)root] = low[(size_t)root] = clock++;
+    stack.push_back({ root, -1, g.cursor(root) });
+
+    while (!stack.empty()) {
+        Frame& f = stack.back();
+        if (f.it.next()) {
+            int u = f.it.target;
+            int e = f.it.edge;
+            if (e == f.parentEdge || !visible(u)) continue;
+
+            if (disc[(size_t)u] < 0) {
+                edgeStack.push_back(e);
+                disc[(size_t)u] = low[(size_t)u] = clock++;
+                stack.push_back({ u, e, g.cursor(u) });   // f is invalid from here
+            }
+            else if (disc[(size_t)u] < disc[(size_t)f.v]) {
+                edgeStack.push_back(e);   // back edge, seen once from its lower end
+                low[(size_t)f.v] = std::min(low[(size_t)f.v], disc[(size_t)u]);
+            }
+            continue;
+        }
+
+        int v = f.v;
+        int e = f.parentEdge;
+        stack.pop_back();
+        if (stack.empty()) break;
+
+        int p = stack.back().v;
+        low[(size_t)p] = std::min(low[(size_t)p], low[(size_t)v]);
+        if (low[(size_t)v] >= disc[(size_t)p]) closeBlock(e);
+    }
+    return t;
+}
+
+std::vector<int> BlockCutTree::route(int s, int t, std::vector<int>* joints) const {
+    if (joints) joints->clear();
+    if (s == t || !reached(s) || !reached(t)) return {};
+
+    // tree nodes: blocks 0..B-1, then one per cut vertex
+    const int B = blockCount();
+    std::vector<int> cutIndex(cut.size(), -1);
+    std::vector<int> cutNode;
+    for (size_t v = 0; v < cut.size(); ++v) {
+        if (!cut[v]) continue;
+        cutIndex[v] = B + (int)cutNode.size();
+        cutNode.push_back((int)v);
+    }
+    const size_t T = (size_t)B + cutNode.size();
+
+    std::vector<std::vector<int>> adj(T);
+    for (int b = 0; b < B; ++b) {
+        for (const int* v = blockBegin(b); v != blockEnd(b); ++v) {
+            if (!cut[(size_t)*v]) continue;
+            adj[(size_t)b].push_back(cutIndex[(size_t)*v]);
+            adj[(size_t)cutIndex[(size_t)*v]].push_back(b);
+        }
+    }
+
+    auto treeNode = [&](int v) { return cut[(size_t)v] ? cutIndex[(size_t)v] : home[(size_t)v]; };
+    int from = treeNode(s);
+    int to = treeNode(t);
+
+    std::vector<int> parent(T, -1);
+    std::vector<int> queue{ from };
+    parent[(size_t)from] = from;
+    for (size_t head = 0; head < queue.size() && parent[(size_t)to] < 0; ++head) {
+        for (int x : adj[(size_t)queue[head]]) {
+            if (parent[(size_t)x] >= 0) continue;
+            parent[(size_t)x] = queue[head];
+            queue.push_back(x);
+        }
+    }
+
+    std::vector<int> blocks;
+    for (int x = to;; x = parent[(size_t)x]) {
+        if (x < B) blocks.push_back(x);
+        else if (x != from && x != to && joints) joints->push_back(cutNode[(size_t)(x - B)]);
+        if (x == from) break;
+    }
+    std::reverse(blocks.begin(), blocks.end());
+    if (joints) std::reverse(joints->begin(), joints->end());
+    return blocks;
+}
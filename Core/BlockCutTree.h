@@ -0,0 +1,36 @@
+﻿#pragma once
+#include "Graph.h"
+#include <vector>
+
+// Biconnected blocks of the component around one root node, found by an
+// iterative Tarjan pass (explicit stack, so depth is not limited by the
+// call stack). Linear in the size of that component.
+//
+// Every simple path between two nodes stays inside the blocks on the
+// block-cut tree path between them, entering and leaving each block through
+// the cut vertices that join it to its neighbors on that path.
+class BlockCutTree {
+public:
+    // keep (optional) hides nodes with keep[v] == 0
+    static BlockCutTree build(const Graph& g, int root, const std::vector<char>* keep = nullptr);
+
+    int blockCount() const { return (int)blockOffsets.size() - 1; }
+
+    // nodes of block b, ascending
+    const int* blockBegin(int b) const { return blockNodes.data() + blockOffsets[(size_t)b]; }
+    const int* blockEnd(int b) const { return blockNodes.data() + blockOffsets[(size_t)b + 1]; }
+
+    bool isCut(int v) const { return cut[(size_t)v] != 0; }
+    bool reached(int v) const { return home[(size_t)v] >= 0; }
+
+    // Blocks on the tree path from s to t, in order; joints[i] is the cut
+    // vertex between blocks[i] and blocks[i + 1]. Empty if t is not reached
+    // or s == t.
+    std::vector<int> route(int s, int t, std::vector<int>* joints = nullptr) const;
+
+private:
+    std::vector<int> blockOffsets{ 0 };
+    std::vector<int> blockNodes;
+    std::vector<char> cut;
+    std::vector<int> home;   // some block holding v, -1 if not reached
+};
@@ -0,0 +1,93 @@
+﻿#include "CompressedAdjacency.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+    // at most this many passes over the endpoints, with windows of at
+    // least MIN_WINDOW slots
+    constexpr size_t MAX_PASSES = 8;
+    constexpr size_t MIN_WINDOW = size_t(1) << 16;
+
+    // Appends the row of v: its degree, then the deltas of (target, edge id)
+    // pairs sorted by target
+    template <class Slot>
+    void putRow(AlignedVector<uint8_t>& out, size_t v, size_t count, Slot slot) {
+        Varint::put(out, (uint64_t)count);
+
+        int64_t prevTarget = (int64_t)v;
+        int64_t prevEdge = 0;
+        for (size_t k = 0; k < count; ++k) {
+            std::pair<int, int> s = slot(k);
+            Varint::put(out, Varint::zigzag(s.first - prevTarget));
+            Varint::put(out, Varint::zigzag(s.second - prevEdge));
+            prevTarget = s.first;
+            prevEdge = s.second;
+        }
+    }
+}
+
+CompressedAdjacency CompressedAdjacency::fromCsr(size_t n, const int* offsets, const int* targets, const int* edgeIds) {
+    CompressedAdjacency c;
+    c.offsets.resize(n + 1);
+    c.data.reserve((size_t)offsets[n] * 3 + n);
+
+    for (size_t v = 0; v < n; ++v) {
+        c.offsets[v] = c.data.size();
+        int from = offsets[v];
+        putRow(c.data, v, (size_t)(offsets[v + 1] - from),
+            [&](size_t k) { return std::make_pair(targets[from + (int)k], edgeIds[from + (int)k]); });
+    }
+    c.offsets[n] = c.data.size();
+    c.data.shrink_to_fit();
+    return c;
+}
+
+CompressedAdjacency CompressedAdjacency::fromEdges(size_t n, size_t m, const int* nodeA, const int* nodeB) {
+    CompressedAdjacency c;
+    c.offsets.resize(n + 1);
+
+    std::vector<int> degree(n, 0);
+    for (size_t id = 0; id < m; ++id) {
+        ++degree[(size_t)nodeA[id]];
+        ++degree[(size_t)nodeB[id]];
+    }
+
+    const size_t window = std::max(MIN_WINDOW, (2 * m + MAX_PASSES - 1) / MAX_PASSES);
+    std::vector<size_t> rowStart;
+    std::vector<size_t> fill;
+    std::vector<std::pair<int, int>> slots;   // (target, edge id)
+
+    for (size_t v0 = 0; v0 < n;) {
+        // rows [v0, v1) fit the window
+        size_t v1 = v0;
+        size_t count = 0;
+        while (v1 < n && (v1 == v0 || count + (size_t)degree[v1] <= window)) count += (size_t)degree[v1++];
+
+        rowStart.assign(v1 - v0 + 1, 0);
+        for (size_t v = v0; v < v1; ++v) rowStart[v - v0 + 1] = rowStart[v - v0] + (size_t)degree[v];
+        fill.assign(rowStart.begin(), rowStart.end() - 1);
+        slots.resize(count);
+
+        // edge ids come in ascending order, which the sort below keeps for
+        // parallel edges, as in the CSR
+        for (size_t id = 0; id < m; ++id) {
+            size_t a = (size_t)nodeA[id];
+            size_t b = (size_t)nodeB[id];
+            if (a >= v0 && a < v1) slots[fill[a - v0]++] = { (int)b, (int)id };
+            if (b >= v0 && b < v1) slots[fill[b - v0]++] = { (int)a, (int)id };
+        }
+
+        for (size_t v = v0; v < v1; ++v) {
+            auto first = slots.begin() + (std::ptrdiff_t)rowStart[v - v0];
+            auto last = slots.begin() + (std::ptrdiff_t)rowStart[v - v0 + 1];
+            std::sort(first, last);
+            c.offsets[v] = c.data.size();
+            putRow(c.data, v, (size_t)(last - first), [&](size_t k) { return first[(std::ptrdiff_t)k]; });
+        }
+        v0 = v1;
+    }
+    c.offsets[n] = c.data.size();
+    c.data.shrink_to_fit();
+    return c;
+}
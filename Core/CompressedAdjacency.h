@@ -0,0 +1,60 @@
+﻿#pragma once
+#include "AlignedAllocator.h"
+#include <cstddef>
+#include <cstdint>
+
+// Varint helpers shared by the encoder and NeighborCursor
+namespace Varint {
+    inline void put(AlignedVector<uint8_t>& out, uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back((uint8_t)v);
+    }
+
+    inline uint64_t get(const uint8_t*& p) {
+        uint64_t v = *p & 0x7f;
+        int shift = 7;
+        while (*p++ & 0x80) {
+            v |= (uint64_t)(*p & 0x7f) << shift;
+            shift += 7;
+        }
+        return v;
+    }
+
+    inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+    inline int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+}
+
+// Delta/varint encoded adjacency, the compact alternative to the CSR arrays.
+// Row of node v: varint(degree), then per neighbor (ascending target)
+// zigzag(target - previous target) and zigzag(edge id - previous edge id),
+// where "previous" starts at (v, 0). After locality reordering most deltas
+// fit in one byte, so a slot costs ~2-4 bytes instead of 8.
+class CompressedAdjacency {
+public:
+    // Encodes a CSR adjacency whose rows are sorted by target
+    static CompressedAdjacency fromCsr(size_t n, const int* offsets, const int* targets, const int* edgeIds);
+
+    // Same rows straight from the edge endpoints, without the CSR: rows
+    // are gathered and encoded a window at a time, so only about 2m / 8
+    // slots (at least 64K, or one whole row) are ever held uncompressed.
+    // Costs one pass over the endpoints per window.
+    static CompressedAdjacency fromEdges(size_t n, size_t m, const int* nodeA, const int* nodeB);
+
+    const uint8_t* rowBegin(int v) const { return data.data() + offsets[(size_t)v]; }
+    const uint8_t* rowEnd(int v) const { return data.data() + offsets[(size_t)v + 1]; }
+
+    int degree(int v) const {
+        const uint8_t* p = rowBegin(v);
+        return (int)Varint::get(p);
+    }
+
+    size_t nodeCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t bytes() const { return data.size() + offsets.size() * sizeof(uint64_t); }
+
+private:
+    AlignedVector<uint64_t> offsets;   // byte offset of every row, size n + 1
+    AlignedVector<uint8_t> data;
+};
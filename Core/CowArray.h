@@ -0,0 +1,110 @@
+﻿#pragma once
+#include "AlignedAllocator.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Copy-on-write containers behind Graph. Copying a Graph only bumps
+// reference counts; a mutation first detaches the touched buffer (or page)
+// if another copy still shares it. Published snapshots are never mutated,
+// so readers need no locks (see GraphStore).
+
+// Whole-array copy on write: topology that is rebuilt, not patched.
+template <class T>
+class CowVector {
+public:
+    using Storage = AlignedVector<T>;
+
+    CowVector() : buf(std::make_shared<Storage>()) {}
+    CowVector(Storage v) : buf(std::make_shared<Storage>(std::move(v))) {}
+
+    CowVector& operator=(Storage v) {
+        buf = std::make_shared<Storage>(std::move(v));
+        return *this;
+    }
+
+    size_t size() const { return buf->size(); }
+    bool empty() const { return buf->empty(); }
+
+    const T* data() const { return buf->data(); }
+    const T& operator[](size_t i) const { return (*buf)[i]; }
+    const T* begin() const { return buf->data(); }
+    const T* end() const { return buf->data() + buf->size(); }
+
+    // Mutable access detaches from other copies first
+    Storage& mut() {
+        if (buf.use_count() > 1) buf = std::make_shared<Storage>(*buf);
+        return *buf;
+    }
+
+    void reserve(size_t n) { mut().reserve(n); }
+    void clear() { mut().clear(); }
+    void push_back(const T& v) { mut().push_back(v); }
+    void assign(size_t n, const T& v) { mut().assign(n, v); }
+    void set(size_t i, const T& v) { mut()[i] = v; }
+
+    // Private copy of the buffer, made by the calling thread
+    void unshare() { buf = std::make_shared<Storage>(*buf); }
+
+private:
+    std::shared_ptr<Storage> buf;
+};
+
+// Paged copy on write: a mutation copies only the page it lands on, so a
+// new version of a large column costs (changed pages x page size).
+template <class T, size_t PageBits = 12>
+class PagedColumn {
+public:
+    static constexpr size_t PAGE_BITS = PageBits;
+    static constexpr size_t PAGE_SIZE = size_t(1) << PageBits;
+    static constexpr size_t PAGE_MASK = PAGE_SIZE - 1;
+
+    struct alignas(64) Page {
+        T v[PAGE_SIZE];
+    };
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t bytes() const { return pages.size() * sizeof(Page); }
+
+    T operator[](size_t i) const { return pages[i >> PageBits]->v[i & PAGE_MASK]; }
+
+    void set(size_t i, T value) { detach(i >> PageBits).v[i & PAGE_MASK] = value; }
+
+    void push_back(T value) {
+        if ((count & PAGE_MASK) == 0) pages.push_back(std::make_shared<Page>());
+        detach(count >> PageBits).v[count & PAGE_MASK] = value;
+        ++count;
+    }
+
+    void reserve(size_t n) { pages.reserve((n + PAGE_MASK) >> PageBits); }
+
+    void clear() {
+        pages.clear();
+        count = 0;
+    }
+
+    // Private copies of all pages, made by the calling thread
+    void unshare() {
+        for (auto& pg : pages) pg = std::make_shared<Page>(*pg);
+    }
+
+    // page-wise access for kernels that stream a column
+    size_t pageCount() const { return pages.size(); }
+    const T* page(size_t p) const { return pages[p]->v; }
+
+    // true if page p is the same memory in both columns (not copied yet)
+    bool sharesPage(const PagedColumn& other, size_t p) const {
+        return p < pages.size() && p < other.pages.size() && pages[p] == other.pages[p];
+    }
+
+private:
+    std::vector<std::shared_ptr<Page>> pages;
+    size_t count = 0;
+
+    Page& detach(size_t p) {
+        if (pages[p].use_count() > 1) pages[p] = std::make_shared<Page>(*pages[p]);
+        return *pages[p];
+    }
+};
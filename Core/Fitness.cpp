@@ -0,0 +1,345 @@
+﻿#include "Fitness.h"
+#include "NodeMarks.h"
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+static thread_local NodeMarks visited;
+
+template <class Objective>
+double BasicFitness<Objective>::hopCost(double latency, double bandwidth) {
+    double lat = std::max(0.001, latency);
+    double bw = std::max(0.001, bandwidth);
+    return Objective::hopCost(lat, lat / bw);
+}
+
+// Weights::hop(id) supplies the clamped hop terms, Weights::perf(v) the
+// node performance. Sums no term of the objective reads are skipped.
+template <class Objective, class Weights>
+static double score(const Graph& g, const std::vector<int>& path, const Weights& w) {
+    constexpr unsigned needs = Objective::needs;
+    if (path.empty()) return 1e18;
+    if (path.front() != g.start_node) return 1e18;
+    if (path.back() != g.end_node) return 1e18;
+    // adjacency of consecutive nodes is checked by the edge index below
+
+    PathTotals t;
+    t.nodes = path.size();
+
+    // every repeated visit of a node costs one loop unit
+    if constexpr ((needs & NEEDS_LOOPS) != 0) visited.reset(g.nodes.size());
+
+    for (int v : path) {
+        if (!g.hasNode(v)) return 1e18;
+        if constexpr ((needs & NEEDS_LOOPS) != 0) {
+            if (visited.testAndSet(v)) t.loops += 1.0;
+        }
+        if constexpr ((needs & NEEDS_PERF) != 0) t.perf += w.perf((size_t)v);
+    }
+
+    for (size_t i = 1; i < path.size(); ++i) {
+        int id = g.findEdge(path[i - 1], path[i]);
+        if (id < 0) return 1e18;
+
+        if constexpr ((needs & NEEDS_HOPS) != 0) {
+            HopTerms hop = w.hop((size_t)id);
+            t.latency += hop.latency;
+            t.penalty += hop.penalty; // penalty grows if bw small
+        }
+    }
+
+    return Objective::combine(t);
+}
+
+// Edge genome form: the walk itself is the adjacency check. Each sum is
+// taken in the same order as above, so both forms agree bit for bit.
+// Bounded walks compare their lower bound against cutoff up front and
+// every BOUND_STRIDE edges after. The bound counts each edge still to go
+// at the graph's least hop terms. It adds its parts in another order than
+// the score does, so it must pass cutoff by a relative margin far above
+// rounding error before a walk is rejected.
+static constexpr size_t BOUND_STRIDE = 8;
+static constexpr double BOUND_MARGIN = 1e-9;
+
+template <class Objective>
+static bool beyond(const Graph& g, PathTotals t, size_t remaining, double rest, double cutoff) {
+    t.latency += (double)remaining * g.hopFloor.latency;
+    t.penalty += (double)remaining * g.hopFloor.penalty;
+    return Objective::grown(t) + rest > cutoff + BOUND_MARGIN * std::abs(cutoff);
+}
+
+// Whether the walk from v over edges[from..] is valid and ends at end_node.
+// A bounded walk checks this before it returns REJECTED, so an invalid walk
+// scores 1e18 whatever the cutoff; only the edges not yet walked are read.
+static bool validRest(const Graph& g, int v, const std::vector<int>& edges, size_t from) {
+    const int m = (int)g.edges.size();
+    for (size_t k = from; k < edges.size(); ++k) {
+        if (edges[k] < 0 || edges[k] >= m) return false;
+        v = g.across(edges[k], v);
+        if (v < 0) return false;
+    }
+    return v == g.end_node;
+}
+
+template <class Objective, class Weights, bool Bounded = false>
+static double score(const Graph& g, int start, const std::vector<int>& edges, const Weights& w,
+    double cutoff = 0.0) {
+    constexpr unsigned needs = Objective::needs;
+    if (start != g.start_node || !g.hasNode(start)) return 1e18;
+
+    PathTotals t;
+    t.nodes = edges.size() + 1;
+    double rest = 0.0;
+    if constexpr (Bounded) {
+        // the length alone may rule out a long walk
+        rest = Objective::floorRest(g.perfCeiling);
+        if (beyond<Objective>(g, t, edges.size(), rest, cutoff))
+            return validRest(g, start, edges, 0) ? BasicFitness<Objective>::REJECTED : 1e18;
+    }
+    if constexpr ((needs & NEEDS_PERF) != 0) t.perf = w.perf((size_t)start);
+    if constexpr ((needs & NEEDS_LOOPS) != 0) {
+        visited.reset(g.nodes.size());
+        visited.set(start);
+    }
+
+    const int m = (int)g.edges.size();
+    int v = start;
+    for (size_t k = 0; k < edges.size(); ++k) {
+        int id = edges[k];
+        if (id < 0 || id >= m) return 1e18;
+        v = g.across(id, v);
+        if (v < 0) return 1e18;
+
+        if constexpr ((needs & NEEDS_LOOPS) != 0) {
+            if (visited.testAndSet(v)) t.loops += 1.0;
+        }
+        if constexpr ((needs & NEEDS_PERF) != 0) t.perf += w.perf((size_t)v);
+        if constexpr ((needs & NEEDS_HOPS) != 0) {
+            HopTerms hop = w.hop((size_t)id);
+            t.latency += hop.latency;
+            t.penalty += hop.penalty;
+        }
+        if constexpr (Bounded) {
+            if (k % BOUND_STRIDE == BOUND_STRIDE - 1 && beyond<Objective>(g, t, edges.size() - k - 1, rest, cutoff))
+                return validRest(g, v, edges, k + 1) ? BasicFitness<Objective>::REJECTED : 1e18;
+        }
+    }
+    if (v != g.end_node) return 1e18;
+
+    return Objective::combine(t);
+}
+
+namespace {
+    // straight from the weight columns; the reference the others must match
+    struct ExactWeights {
+        const Graph& g;
+
+        HopTerms hop(size_t id) const {
+            double lat = std::max(0.001, (double)g.edges.latency[id]);
+            double bw = std::max(0.001, (double)g.edges.bandwidth[id]);
+            return { lat, lat / bw };
+        }
+        double perf(size_t v) const { return (double)g.nodes[v].performance; }
+    };
+
+    // Graph::precomputeCosts columns: same values, no clamping or division
+    struct PrecomputedWeights {
+        const Graph& g;
+
+        HopTerms hop(size_t id) const { return g.hopTerms[id]; }
+        double perf(size_t v) const { return g.nodePerf[v]; }
+    };
+
+    // a compressed graph keeps no hop columns: the same terms, computed as read
+    struct ComputedWeights {
+        const Graph& g;
+
+        HopTerms hop(size_t id) const { return HopTerms::of((double)g.edges.latency[id], (double)g.edges.bandwidth[id]); }
+        double perf(size_t v) const { return g.nodePerf[v]; }
+    };
+
+    struct PackedWeights {
+        const Graph& g;
+        const QuantizedWeights& q;
+
+        HopTerms hop(size_t id) const { return { std::max(0.001, q.latency[id]), q.penalty[id] }; }
+        double perf(size_t v) const { return g.nodePerf[v]; }
+    };
+
+    // f(weights) with whatever g scores from
+    template <class F>
+    auto withWeights(const Graph& g, F&& f) {
+        if (g.quantized) return f(PackedWeights{ g, *g.quantized });
+        if (g.hasHopColumns()) return f(PrecomputedWeights{ g });
+        return f(ComputedWeights{ g });
+    }
+}
+
+template <class Objective>
+double BasicFitness<Objective>::evaluate(const Graph& g, const std::vector<int>& path) {
+    return withWeights(g, [&](const auto& w) { return score<Objective>(g, path, w); });
+}
+
+template <class Objective>
+double BasicFitness<Objective>::evaluateExact(const Graph& g, const std::vector<int>& path) {
+    return score<Objective>(g, path, ExactWeights{ g });
+}
+
+template <class Objective>
+double BasicFitness<Objective>::evaluate(const Graph& g, int start, const std::vector<int>& edges) {
+    return withWeights(g, [&](const auto& w) { return score<Objective>(g, start, edges, w); });
+}
+
+template <class Objective>
+double BasicFitness<Objective>::evaluateExact(const Graph& g, int start, const std::vector<int>& edges) {
+    return score<Objective>(g, start, edges, ExactWeights{ g });
+}
+
+template <class Objective>
+double BasicFitness<Objective>::evaluateBounded(const Graph& g, int start, const std::vector<int>& edges,
+    double cutoff) {
+    return withWeights(g, [&](const auto& w) {
+        return score<Objective, std::decay_t<decltype(w)>, true>(g, start, edges, w, cutoff);
+    });
+}
+
+template <class Weights>
+static bool totals(const Graph& g, int start, const std::vector<int>& edges, const Weights& w, PathTotals& t) {
+    if (start != g.start_node || !g.hasNode(start)) return false;
+
+    t = PathTotals();
+    t.nodes = edges.size() + 1;
+    t.perf = w.perf((size_t)start);
+    visited.reset(g.nodes.size());
+    visited.set(start);
+
+    const int m = (int)g.edges.size();
+    int v = start;
+    for (int id : edges) {
+        if (id < 0 || id >= m) return false;
+        v = g.across(id, v);
+        if (v < 0) return false;
+
+        if (visited.testAndSet(v)) t.loops += 1.0;
+        t.perf += w.perf((size_t)v);
+        HopTerms hop = w.hop((size_t)id);
+        t.latency += hop.latency;
+        t.penalty += hop.penalty;
+    }
+    return v == g.end_node;
+}
+
+template <class Objective>
+bool BasicFitness<Objective>::walkTotals(const Graph& g, int start, const std::vector<int>& edges, PathTotals& out) {
+    return withWeights(g, [&](const auto& w) { return totals(g, start, edges, w, out); });
+}
+
+// Appends the walk over `middle` to out, looking up each edge
+template <class Weights>
+static bool extend(const Graph& g, const std::vector<int>& middle, const Weights& w, PathSums& out) {
+    const int m = (int)g.edges.size();
+    int v = out.nodes.back();
+    double latency = out.latency.back();
+    double penalty = out.penalty.back();
+    double perf = out.perf.back();
+    int repeats = out.repeats.back();
+
+    for (int id : middle) {
+        if (id < 0 || id >= m) return false;
+        v = g.across(id, v);
+        if (v < 0) return false;
+
+        if (visited.testAndSet(v)) ++repeats;
+        HopTerms hop = w.hop((size_t)id);
+        latency += hop.latency;
+        penalty += hop.penalty;
+        perf += w.perf((size_t)v);
+
+        out.nodes.push_back(v);
+        out.latency.push_back(latency);
+        out.penalty.push_back(penalty);
+        out.perf.push_back(perf);
+        out.repeats.push_back(repeats);
+    }
+    return true;
+}
+
+template <class Objective>
+bool BasicFitness<Objective>::walkSums(const Graph& g, int start, const std::vector<int>& edges, PathSums& out) {
+    if (!g.hasNode(start)) return false;
+    PathSums head;
+    head.nodes = { start };
+    head.latency = { 0.0 };
+    head.penalty = { 0.0 };
+    head.perf = { g.nodePerf[(size_t)start] };
+    head.repeats = { 0 };
+    return spliceSums(g, head, 0, edges, nullptr, 0, out);
+}
+
+template <class Objective>
+bool BasicFitness<Objective>::spliceSums(const Graph& g, const PathSums& head, size_t keep,
+    const std::vector<int>& middle, const PathSums* tail, size_t from, PathSums& out) {
+    auto prefix = [keep](auto& to, const auto& v) { to.assign(v.begin(), v.begin() + (std::ptrdiff_t)keep + 1); };
+    prefix(out.nodes, head.nodes);
+    prefix(out.latency, head.latency);
+    prefix(out.penalty, head.penalty);
+    prefix(out.perf, head.perf);
+    prefix(out.repeats, head.repeats);
+
+    // the head's own revisits are counted already; later nodes test against it
+    visited.reset(g.nodes.size());
+    for (int v : out.nodes) visited.set(v);
+
+    bool ok = withWeights(g, [&](const auto& w) { return extend(g, middle, w, out); });
+    if (!ok) return false;
+    if (!tail) return true;
+    if (tail->nodes[from] != out.nodes.back()) return false;
+
+    const double latency = out.latency.back() - tail->latency[from];
+    const double penalty = out.penalty.back() - tail->penalty[from];
+    const double perf = out.perf.back() - tail->perf[from];
+    int repeats = out.repeats.back();
+    for (size_t k = from + 1; k < tail->nodes.size(); ++k) {
+        int v = tail->nodes[k];
+        if (visited.testAndSet(v)) ++repeats;
+        out.nodes.push_back(v);
+        out.latency.push_back(latency + tail->latency[k]);
+        out.penalty.push_back(penalty + tail->penalty[k]);
+        out.perf.push_back(perf + tail->perf[k]);
+        out.repeats.push_back(repeats);
+    }
+    return true;
+}
+
+// The running sums always cover every term; the objective picks what it reads
+template <class Objective>
+double BasicFitness<Objective>::evaluate(const Graph& g, const PathSums& sums) {
+    if (sums.nodes.empty()) return 1e18;
+    if (sums.nodes.front() != g.start_node) return 1e18;
+    if (sums.nodes.back() != g.end_node) return 1e18;
+
+    PathTotals t;
+    t.latency = sums.latency.back();
+    t.penalty = sums.penalty.back();
+    t.perf = sums.perf.back();
+    t.loops = (double)sums.repeats.back();
+    t.nodes = sums.nodes.size();
+    return Objective::combine(t);
+}
+
+// evaluateBatch and bestBatchKernel are instantiated in FitnessBatch.cpp
+#define OPTNET_INSTANTIATE_FITNESS(Objective, name) \
+    template double BasicFitness<Objective>::evaluate(const Graph&, const std::vector<int>&); \
+    template double BasicFitness<Objective>::evaluateExact(const Graph&, const std::vector<int>&); \
+    template double BasicFitness<Objective>::evaluate(const Graph&, int, const std::vector<int>&); \
+    template double BasicFitness<Objective>::evaluateExact(const Graph&, int, const std::vector<int>&); \
+    template double BasicFitness<Objective>::evaluateBounded(const Graph&, int, const std::vector<int>&, double); \
+    template bool BasicFitness<Objective>::walkTotals(const Graph&, int, const std::vector<int>&, PathTotals&); \
+    template bool BasicFitness<Objective>::walkSums(const Graph&, int, const std::vector<int>&, PathSums&); \
+    template bool BasicFitness<Objective>::spliceSums(const Graph&, const PathSums&, size_t, \
+        const std::vector<int>&, const PathSums*, size_t, PathSums&); \
+    template double BasicFitness<Objective>::evaluate(const Graph&, const PathSums&); \
+    template double BasicFitness<Objective>::hopCost(double, double);
+
+OPTNET_OBJECTIVES(OPTNET_INSTANTIATE_FITNESS)
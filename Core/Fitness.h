@@ -0,0 +1,119 @@
+﻿#pragma once
+#include "Graph.h"
+#include "Objective.h"
+#include <limits>
+#include <vector>
+
+// A generation of edge genomes laid out back to back: path i walks
+// edges[offsets[i] .. offsets[i + 1]) from starts[i]
+struct PathBatch {
+    std::vector<int> starts;
+    std::vector<int> offsets{ 0 };
+    std::vector<int> edges;
+
+    size_t size() const { return starts.size(); }
+
+    void clear() {
+        starts.clear();
+        offsets.assign(1, 0);
+        edges.clear();
+    }
+
+    void add(int start, const std::vector<int>& genome) {
+        starts.push_back(start);
+        edges.insert(edges.end(), genome.begin(), genome.end());
+        offsets.push_back((int)edges.size());
+    }
+};
+
+// Running sums along a walk, so a child spliced from parents can be scored
+// without re-walking what it inherits (see Fitness::spliceSums). Entry k
+// covers the first k edges, i.e. nodes[0..k].
+struct PathSums {
+    std::vector<int> nodes;
+    std::vector<double> latency;   // clamped hop latencies
+    std::vector<double> penalty;   // latency / bandwidth terms
+    std::vector<double> perf;      // node performance, nodes[0..k]
+    std::vector<int> repeats;      // revisits among nodes[0..k]
+};
+
+// Kernels of Fitness::evaluateBatch. Best picks the widest one the CPU runs;
+// asking for one it can't run also falls back to that.
+enum class BatchKernel {
+    Best,
+    Scalar,
+    AVX2,     // 4 paths per step
+    AVX512    // 8 paths per step
+};
+
+// Path scores under an objective policy (Objective.h). The walks only sum
+// what the objective's terms read. Defined in Fitness.cpp and
+// FitnessBatch.cpp for each of OPTNET_OBJECTIVES.
+template <class Objective>
+class BasicFitness {
+public:
+    // Lower is better. Sums the precomputed hop terms of g (bit-identical
+    // to evaluateExact), or the 16-bit weights when g has them.
+    static double evaluate(const Graph& g, const std::vector<int>& path);
+
+    // Same score computed from the weight columns themselves; the reference
+    // for the precomputed terms and for results found on a quantized graph
+    static double evaluateExact(const Graph& g, const std::vector<int>& path);
+
+    // Both scores for an edge genome (Individual.h): the walk from start
+    // over the given edge ids. Equal to the node path forms whenever the
+    // walk takes the edges findEdge would pick.
+    static double evaluate(const Graph& g, int start, const std::vector<int>& edges);
+    static double evaluateExact(const Graph& g, int start, const std::vector<int>& edges);
+
+    // What evaluateBounded returns for a walk that can't score cutoff or less
+    static constexpr double REJECTED = std::numeric_limits<double>::infinity();
+
+    // evaluate(g, start, edges), but the walk stops as soon as the sums so
+    // far plus the best the rest could do (Objective::grown/floorRest, the
+    // graph's hopFloor) exceed cutoff, and returns REJECTED. Never rejects a
+    // walk scoring cutoff or less; invalid walks still score 1e18.
+    static double evaluateBounded(const Graph& g, int start, const std::vector<int>& edges, double cutoff);
+
+    // Fitness::evaluate(g, start, edges) of every path in the batch, bit for
+    // bit, into scores. The SIMD kernels walk several paths in lockstep, one
+    // per lane, gathering the hop terms and node performance; the loop
+    // check stays scalar. Quantized graphs, and compressed ones (no hop
+    // columns to gather), are scored path by path.
+    static void evaluateBatch(const Graph& g, const PathBatch& batch, std::vector<double>& scores,
+        BatchKernel kernel = BatchKernel::Best);
+
+    // Every sum of the walk from start, whatever the objective reads (for
+    // scoring them another way, see GA::runPareto); false unless it is a
+    // valid walk from start_node to end_node
+    static bool walkTotals(const Graph& g, int start, const std::vector<int>& edges, PathTotals& out);
+
+    // Running sums of the walk from start; false if an edge doesn't continue it
+    static bool walkSums(const Graph& g, int start, const std::vector<int>& edges, PathSums& out);
+
+    // Sums of head.nodes[0..keep], then the walk over the new edges in middle,
+    // then tail's walk from its node `from` on (no tail if null). Only the
+    // middle edges are looked up; head and tail give their running sums and
+    // the loop count rechecks node ids only. The tail part is a difference of
+    // running sums, so with a tail the score may differ from evaluate() in
+    // the last bits. False if middle or tail doesn't continue the walk.
+    static bool spliceSums(const Graph& g, const PathSums& head, size_t keep,
+        const std::vector<int>& middle, const PathSums* tail, size_t from, PathSums& out);
+
+    // Score of a walk from its running sums
+    static double evaluate(const Graph& g, const PathSums& sums);
+
+    // The kernel BatchKernel::Best resolves to on this CPU
+    static BatchKernel bestBatchKernel();
+
+    // What one hop over an edge adds to the score (latency, bandwidth and hop terms)
+    static double hopCost(double latency, double bandwidth);
+
+    // The score of a walk from its totals
+    static double combine(const PathTotals& totals) { return Objective::combine(totals); }
+};
+
+// The solver's own objective. The graph's precomputed hop cost column
+// (Graph::hopCost) uses this one; cheapest-path searches for the others
+// combine the hop terms themselves (GraphView::hopCost).
+using Fitness = BasicFitness<DefaultObjective>;
@@ -0,0 +1,327 @@
+﻿#include "Fitness.h"
+#include "NodeMarks.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define OPTNET_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define OPTNET_TARGET(isa)
+#else
+#define OPTNET_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+using HopColumn = PagedColumn<HopTerms>;
+static_assert(sizeof(HopTerms) == 16, "the kernels address HopTerms as two doubles");
+
+// Scratch reused across batches
+static thread_local NodeMarks batchVisited;
+static thread_local std::vector<const HopTerms*> hopPages;
+static thread_local std::vector<int> walked;          // nodes of path i from offsets[i] + i
+static thread_local std::vector<double> sumLatency;
+static thread_local std::vector<double> sumPenalty;
+static thread_local std::vector<double> sumPerf;
+static thread_local std::vector<int> walkEnd;         // last node, -1 if the walk broke
+static thread_local std::vector<int> genome;
+
+namespace {
+    // What the walk kernels read and write. Every kernel sums in path
+    // order, so its sums equal those of Fitness::evaluate bit for bit.
+    // They are instantiated per objective; sums and walked nodes no term
+    // of it reads are neither gathered nor stored.
+    struct BatchContext {
+        const Graph& g;
+        const PathBatch& batch;
+        int edgeCount;
+        const int* edges;
+        const int* nodeA;
+        const int* nodeB;
+        const double* perf;
+        const HopTerms* const* pages;   // HopColumn pages, for two-level gathers
+    };
+}
+
+template <class Objective>
+static void walkScalar(const BatchContext& c, size_t i) {
+    constexpr unsigned needs = Objective::needs;
+    const int* offsets = c.batch.offsets.data();
+    int v = c.batch.starts[i];
+    int* out = walked.data() + offsets[i] + i;
+    *out = v;
+    walkEnd[i] = -1;
+    if (v != c.g.start_node) return;
+
+    double latency = 0.0;
+    double penalty = 0.0;
+    double perf = (needs & NEEDS_PERF) ? c.perf[v] : 0.0;
+    for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+        int id = c.edges[k];
+        if (id < 0 || id >= c.edgeCount) return;
+        v = c.g.across(id, v);
+        if (v < 0) return;
+
+        if constexpr ((needs & NEEDS_PERF) != 0) perf += c.perf[v];
+        if constexpr ((needs & NEEDS_HOPS) != 0) {
+            HopTerms hop = c.pages[(size_t)id >> HopColumn::PAGE_BITS][(size_t)id & HopColumn::PAGE_MASK];
+            latency += hop.latency;
+            penalty += hop.penalty;
+        }
+        if constexpr ((needs & NEEDS_LOOPS) != 0) *++out = v;
+    }
+    sumLatency[i] = latency;
+    sumPenalty[i] = penalty;
+    sumPerf[i] = perf;
+    walkEnd[i] = v;
+}
+
+#ifdef OPTNET_X86
+
+// Paths p0 .. p0 + 3, one per lane. The gathers are masked only by what
+// makes their indices safe (path length, edge id range), not by the walk so
+// far: a lane whose walk broke keeps gathering valid entries and scores
+// 1e18 anyway. So a step waits on the previous one only through the compare
+// that advances v. Lanes past the end of their path add zeros.
+template <class Objective>
+OPTNET_TARGET("avx2")
+static void walkAvx2(const BatchContext& c, size_t p0) {
+    constexpr unsigned needs = Objective::needs;
+    const int* offsets = c.batch.offsets.data() + p0;
+    const int* first = c.batch.starts.data() + p0;
+    const __m128i path = _mm_add_epi32(_mm_set1_epi32((int)p0), _mm_setr_epi32(0, 1, 2, 3));
+    const __m128i base = _mm_loadu_si128((const __m128i*)offsets);
+    const __m128i len = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(offsets + 1)), base);
+    const __m128i starts = _mm_loadu_si128((const __m128i*)first);
+    const __m128i minusOne = _mm_set1_epi32(-1);
+    const __m128i edgeCount = _mm_set1_epi32(c.edgeCount);
+    const __m128i pageMask = _mm_set1_epi32((int)HopColumn::PAGE_MASK);
+    const __m256i second = _mm256_set1_epi64x(8);
+    const __m128i zero = _mm_setzero_si128();
+    const __m256d zeroPd = _mm256_setzero_pd();
+    const __m256d allPd = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    // walked nodes of path i go from offsets[i] + i
+    alignas(16) int outAt[4];
+    alignas(16) int laneLen[4];
+    _mm_store_si128((__m128i*)outAt, _mm_add_epi32(base, path));
+    _mm_store_si128((__m128i*)laneLen, len);
+    int steps = 0;
+    for (int l = 0; l < 4; ++l) {
+        walked[(size_t)outAt[l]] = first[l];
+        steps = std::max(steps, laneLen[l]);
+    }
+
+    __m128i v = _mm_set1_epi32(c.g.start_node);
+    __m128i broken = _mm_xor_si128(_mm_cmpeq_epi32(starts, v), minusOne);
+    __m256d latency = zeroPd;
+    __m256d penalty = zeroPd;
+    __m256d perf = (needs & NEEDS_PERF) ? _mm256_mask_i32gather_pd(zeroPd, c.perf, v, allPd, 8) : zeroPd;
+
+    alignas(16) int lane[4];
+    for (int k = 0; k < steps; ++k) {
+        const __m128i kk = _mm_set1_epi32(k);
+        __m128i live = _mm_cmpgt_epi32(len, kk);
+        __m128i e = _mm_mask_i32gather_epi32(zero, c.edges, _mm_add_epi32(base, kk), live, 4);
+        __m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(e, minusOne), _mm_cmpgt_epi32(edgeCount, e));
+        broken = _mm_or_si128(broken, _mm_andnot_si128(inRange, live));
+        live = _mm_and_si128(live, inRange);
+
+        __m128i a = _mm_mask_i32gather_epi32(zero, c.nodeA, e, live, 4);
+        __m128i b = _mm_mask_i32gather_epi32(zero, c.nodeB, e, live, 4);
+        __m128i isA = _mm_cmpeq_epi32(a, v);
+        __m128i isB = _mm_cmpeq_epi32(b, v);
+        broken = _mm_or_si128(broken, _mm_andnot_si128(_mm_or_si128(isA, isB), live));
+        v = _mm_blendv_epi8(v, _mm_blendv_epi8(a, b, isA), live);
+
+        // page pointer, then latency and penalty at absolute addresses
+        const __m256i live64 = _mm256_cvtepi32_epi64(live);
+        const __m256d livePd = _mm256_castsi256_pd(live64);
+        if constexpr ((needs & NEEDS_HOPS) != 0) {
+            __m256i page = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), (const long long*)c.pages,
+                _mm_srli_epi32(e, (int)HopColumn::PAGE_BITS), live64, 8);
+            __m256i at = _mm256_add_epi64(page, _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_and_si128(e, pageMask)), 4));
+            latency = _mm256_add_pd(latency, _mm256_mask_i64gather_pd(zeroPd, (const double*)nullptr, at, livePd, 1));
+            penalty = _mm256_add_pd(penalty,
+                _mm256_mask_i64gather_pd(zeroPd, (const double*)nullptr, _mm256_add_epi64(at, second), livePd, 1));
+        }
+        if constexpr ((needs & NEEDS_PERF) != 0)
+            perf = _mm256_add_pd(perf, _mm256_mask_i32gather_pd(zeroPd, c.perf, v, livePd, 8));
+
+        if constexpr ((needs & NEEDS_LOOPS) != 0) {
+            _mm_store_si128((__m128i*)lane, v);
+            for (int l = 0; l < 4; ++l) {
+                if (k < laneLen[l]) walked[(size_t)(outAt[l] + k + 1)] = lane[l];
+            }
+        }
+    }
+
+    _mm256_storeu_pd(sumLatency.data() + p0, latency);
+    _mm256_storeu_pd(sumPenalty.data() + p0, penalty);
+    _mm256_storeu_pd(sumPerf.data() + p0, perf);
+    _mm_storeu_si128((__m128i*)(walkEnd.data() + p0), _mm_or_si128(v, broken));
+}
+
+// Paths p0 .. p0 + 7; the same walk with mask registers, masked adds and
+// a scatter for the walked nodes. The unmasked forms of the gather, widen
+// and shift intrinsics start from an undefined register that GCC warns
+// about, so they are spelled with an all-lanes mask.
+template <class Objective>
+OPTNET_TARGET("avx512f,avx512vl")
+static void walkAvx512(const BatchContext& c, size_t p0) {
+    constexpr unsigned needs = Objective::needs;
+    const int* offsets = c.batch.offsets.data() + p0;
+    const __m256i path = _mm256_add_epi32(_mm256_set1_epi32((int)p0), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i base = _mm256_loadu_si256((const __m256i*)offsets);
+    const __m256i len = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(offsets + 1)), base);
+    const __m256i starts = _mm256_loadu_si256((const __m256i*)(c.batch.starts.data() + p0));
+    const __m256i minusOne = _mm256_set1_epi32(-1);
+    const __m256i edgeCount = _mm256_set1_epi32(c.edgeCount);
+    const __m256i pageMask = _mm256_set1_epi32((int)HopColumn::PAGE_MASK);
+    const __m512i second = _mm512_set1_epi64(8);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m512d zeroPd = _mm512_setzero_pd();
+    const __mmask8 all = 0xFF;
+
+    const __m256i out = _mm256_add_epi32(base, path);
+    _mm256_i32scatter_epi32(walked.data(), out, starts, 4);
+    alignas(32) int laneLen[8];
+    _mm256_store_si256((__m256i*)laneLen, len);
+    const int steps = *std::max_element(laneLen, laneLen + 8);
+
+    __m256i v = _mm256_set1_epi32(c.g.start_node);
+    __mmask8 broken = (__mmask8)~_mm256_cmpeq_epi32_mask(starts, v);
+    __m512d latency = zeroPd;
+    __m512d penalty = zeroPd;
+    __m512d perf = (needs & NEEDS_PERF) ? _mm512_mask_i32gather_pd(zeroPd, all, v, c.perf, 8) : zeroPd;
+
+    for (int k = 0; k < steps; ++k) {
+        const __m256i kk = _mm256_set1_epi32(k);
+        __mmask8 live = _mm256_cmpgt_epi32_mask(len, kk);
+        __m256i e = _mm256_mmask_i32gather_epi32(zero, live, _mm256_add_epi32(base, kk), c.edges, 4);
+        __mmask8 inRange = (__mmask8)(_mm256_cmpgt_epi32_mask(e, minusOne) & _mm256_cmpgt_epi32_mask(edgeCount, e));
+        broken |= (__mmask8)(live & ~inRange);
+        live &= inRange;
+
+        __m256i a = _mm256_mmask_i32gather_epi32(zero, live, e, c.nodeA, 4);
+        __m256i b = _mm256_mmask_i32gather_epi32(zero, live, e, c.nodeB, 4);
+        __mmask8 isA = _mm256_cmpeq_epi32_mask(a, v);
+        __mmask8 isB = _mm256_cmpeq_epi32_mask(b, v);
+        broken |= (__mmask8)(live & ~(isA | isB));
+        v = _mm256_mask_blend_epi32(live, v, _mm256_mask_blend_epi32(isA, a, b));
+
+        if constexpr ((needs & NEEDS_HOPS) != 0) {
+            __m512i page = _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), live,
+                _mm256_srli_epi32(e, (int)HopColumn::PAGE_BITS), c.pages, 8);
+            __m512i slot = _mm512_maskz_cvtepi32_epi64(all, _mm256_and_si256(e, pageMask));
+            __m512i at = _mm512_add_epi64(page, _mm512_maskz_slli_epi64(all, slot, 4));
+            latency = _mm512_mask_add_pd(latency, live, latency, _mm512_mask_i64gather_pd(zeroPd, live, at, nullptr, 1));
+            penalty = _mm512_mask_add_pd(penalty, live, penalty,
+                _mm512_mask_i64gather_pd(zeroPd, live, _mm512_add_epi64(at, second), nullptr, 1));
+        }
+        if constexpr ((needs & NEEDS_PERF) != 0)
+            perf = _mm512_mask_add_pd(perf, live, perf, _mm512_mask_i32gather_pd(zeroPd, live, v, c.perf, 8));
+
+        if constexpr ((needs & NEEDS_LOOPS) != 0)
+            _mm256_mask_i32scatter_epi32(walked.data(), live, _mm256_add_epi32(out, _mm256_set1_epi32(k + 1)), v, 4);
+    }
+
+    _mm512_storeu_pd(sumLatency.data() + p0, latency);
+    _mm512_storeu_pd(sumPenalty.data() + p0, penalty);
+    _mm512_storeu_pd(sumPerf.data() + p0, perf);
+    _mm256_storeu_si256((__m256i*)(walkEnd.data() + p0), _mm256_mask_blend_epi32(broken, v, minusOne));
+}
+
+#endif
+
+template <class Objective>
+BatchKernel BasicFitness<Objective>::bestBatchKernel() {
+    static const BatchKernel best = [] {
+#if defined(OPTNET_X86) && defined(_MSC_VER) && !defined(__clang__)
+        int r[4];
+        __cpuid(r, 0);
+        if (r[0] < 7) return BatchKernel::Scalar;
+        __cpuid(r, 1);
+        if (!(r[2] & (1 << 27))) return BatchKernel::Scalar;   // no OSXSAVE
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(r, 7, 0);
+        bool avx512 = (r[1] & (1 << 16)) && (r[1] & (1 << 31)) && (xcr0 & 0xe6) == 0xe6;
+        bool avx2 = (r[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6;
+        if (avx512) return BatchKernel::AVX512;
+        if (avx2) return BatchKernel::AVX2;
+#elif defined(OPTNET_X86)
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) return BatchKernel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return BatchKernel::AVX2;
+#endif
+        return BatchKernel::Scalar;
+    }();
+    return best;
+}
+
+template <class Objective>
+void BasicFitness<Objective>::evaluateBatch(const Graph& g, const PathBatch& batch, std::vector<double>& scores,
+    BatchKernel kernel) {
+    const size_t count = batch.size();
+    const int* offsets = batch.offsets.data();
+    scores.resize(count);
+
+    // the kernels gather the precomputed columns only
+    if (g.quantized || !g.hasHopColumns()) {
+        for (size_t i = 0; i < count; ++i) {
+            genome.assign(batch.edges.begin() + offsets[i], batch.edges.begin() + offsets[i + 1]);
+            scores[i] = evaluate(g, batch.starts[i], genome);
+        }
+        return;
+    }
+
+    BatchKernel best = bestBatchKernel();
+    if (kernel == BatchKernel::Best || (int)kernel > (int)best) kernel = best;
+
+    hopPages.resize(g.hopTerms.pageCount());
+    for (size_t p = 0; p < hopPages.size(); ++p) hopPages[p] = g.hopTerms.page(p);
+    walked.resize(batch.edges.size() + count);
+    sumLatency.resize(count);
+    sumPenalty.resize(count);
+    sumPerf.resize(count);
+    walkEnd.resize(count);
+
+    BatchContext c{ g, batch, (int)g.edges.size(), batch.edges.data(),
+        g.edges.node_a.data(), g.edges.node_b.data(), g.nodePerf.data(), hopPages.data() };
+
+    size_t i = 0;
+#ifdef OPTNET_X86
+    if (kernel == BatchKernel::AVX512) {
+        for (; i + 8 <= count; i += 8) walkAvx512<Objective>(c, i);
+    }
+    if (kernel == BatchKernel::AVX512 || kernel == BatchKernel::AVX2) {
+        for (; i + 4 <= count; i += 4) walkAvx2<Objective>(c, i);
+    }
+#endif
+    for (; i < count; ++i) walkScalar<Objective>(c, i);
+
+    // loop count and score per path
+    for (i = 0; i < count; ++i) {
+        if (walkEnd[i] != g.end_node) { scores[i] = 1e18; continue; }
+
+        PathTotals t;
+        t.latency = sumLatency[i];
+        t.penalty = sumPenalty[i];
+        t.perf = sumPerf[i];
+        t.nodes = (size_t)(offsets[i + 1] - offsets[i]) + 1;
+        if constexpr ((Objective::needs & NEEDS_LOOPS) != 0) {
+            const int* path = walked.data() + offsets[i] + i;
+            batchVisited.reset(g.nodes.size());
+            for (size_t k = 0; k < t.nodes; ++k) {
+                if (batchVisited.testAndSet(path[k])) t.loops += 1.0;
+            }
+        }
+        scores[i] = combine(t);
+    }
+}
+
+#define OPTNET_INSTANTIATE_BATCH(Objective, name) \
+    template void BasicFitness<Objective>::evaluateBatch(const Graph&, const PathBatch&, \
+        std::vector<double>&, BatchKernel); \
+    template BatchKernel BasicFitness<Objective>::bestBatchKernel();
+
+OPTNET_OBJECTIVES(OPTNET_INSTANTIATE_BATCH)
@@ -0,0 +1,95 @@
+﻿#include "FitnessCache.h"
+#include <algorithm>
+
+static size_t roundUpPow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+FitnessCache::FitnessCache(size_t slots, size_t shardsWanted) {
+    shardCount = roundUpPow2(std::max<size_t>(1, shardsWanted));
+    slotsPerShard = roundUpPow2(std::max<size_t>(1, slots / shardCount));
+
+    int bits = 0;
+    while (((size_t)1 << bits) < shardCount) ++bits;
+    shardShift = 64 - bits;
+
+    shards.reset(new Shard[shardCount]);
+    for (size_t s = 0; s < shardCount; ++s) shards[s].slots.resize(slotsPerShard);
+}
+
+uint64_t FitnessCache::hash(int start, const std::vector<int>& edges) {
+    const uint64_t P = 0x100000001b3ull;
+    uint64_t h = 0xcbf29ce484222325ull ^ (uint64_t)(uint32_t)start;
+    for (int e : edges) h = h * P + (uint64_t)(uint32_t)(e + 1);
+    h ^= (uint64_t)edges.size();
+
+    // splitmix64 finalizer: spreads the low-entropy tail over all bits,
+    // the shard comes from the top ones and the slot from the bottom ones
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+FitnessCache::Shard& FitnessCache::shardOf(uint64_t key) const {
+    return shards[shardShift >= 64 ? 0 : (size_t)(key >> shardShift)];
+}
+
+bool FitnessCache::find(int start, const std::vector<int>& edges, double& fitness) const {
+    lookups.fetch_add(1, std::memory_order_relaxed);
+    uint64_t key = hash(start, edges);
+    Shard& shard = shardOf(key);
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    const Slot& slot = slotOf(shard, key);
+    if (!slot.used || slot.key != key) return false;
+    if (slot.start != start || slot.edges != edges) {
+        collisions.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    fitness = slot.fitness;
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FitnessCache::insert(int start, const std::vector<int>& edges, double fitness) {
+    inserts.fetch_add(1, std::memory_order_relaxed);
+    uint64_t key = hash(start, edges);
+    Shard& shard = shardOf(key);
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    Slot& slot = slotOf(shard, key);
+    if (slot.used && (slot.key != key || slot.start != start || slot.edges != edges))
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    slot.key = key;
+    slot.used = true;
+    slot.start = start;
+    slot.fitness = fitness;
+    slot.edges.assign(edges.begin(), edges.end());
+}
+
+void FitnessCache::clear() {
+    for (size_t s = 0; s < shardCount; ++s) {
+        std::lock_guard<std::mutex> guard(shards[s].lock);
+        for (Slot& slot : shards[s].slots) slot.used = false;
+    }
+    lookups = 0;
+    hits = 0;
+    collisions = 0;
+    inserts = 0;
+    evictions = 0;
+}
+
+FitnessCacheStats FitnessCache::stats() const {
+    FitnessCacheStats s;
+    s.lookups = lookups.load(std::memory_order_relaxed);
+    s.hits = hits.load(std::memory_order_relaxed);
+    s.collisions = collisions.load(std::memory_order_relaxed);
+    s.inserts = inserts.load(std::memory_order_relaxed);
+    s.evictions = evictions.load(std::memory_order_relaxed);
+    return s;
+}
@@ -0,0 +1,71 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct FitnessCacheStats {
+    unsigned long long lookups = 0;
+    unsigned long long hits = 0;
+    unsigned long long collisions = 0;   // hash matched, genome didn't
+    unsigned long long inserts = 0;
+    unsigned long long evictions = 0;    // inserts that replaced another genome
+
+    double hitRate() const { return lookups ? (double)hits / (double)lookups : 0.0; }
+};
+
+// Fixed-size memo of edge genome scores (Individual.h), keyed by a 64-bit
+// rolling hash of start and edges. The slots are direct mapped and split
+// into shards with one lock each, so threads sharing a cache rarely meet.
+// A slot keeps its genome, and a hit is only reported when that equals the
+// one asked for: a hash collision costs a miss, never a wrong score.
+// Scores are only valid for the graph and route policy they were computed
+// on; clear() when either changes.
+class FitnessCache {
+public:
+    // slots and shards are rounded up to powers of two
+    explicit FitnessCache(size_t slots = 1 << 14, size_t shards = 16);
+
+    // h = h * P + (edge + 1) over the edges, seeded with start, then mixed
+    static uint64_t hash(int start, const std::vector<int>& edges);
+
+    // Score of the genome if cached
+    bool find(int start, const std::vector<int>& edges, double& fitness) const;
+
+    // Stores the score, replacing whatever shared the slot
+    void insert(int start, const std::vector<int>& edges, double fitness);
+
+    void clear();
+
+    size_t slots() const { return shardCount * slotsPerShard; }
+    FitnessCacheStats stats() const;
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        bool used = false;
+        int start = -1;
+        double fitness = 0.0;
+        std::vector<int> edges;   // capacity is reused on replacement
+    };
+
+    struct Shard {
+        std::mutex lock;
+        std::vector<Slot> slots;
+    };
+
+    size_t shardCount = 1;
+    size_t slotsPerShard = 1;
+    int shardShift = 64;          // top bits of the key pick the shard
+    std::unique_ptr<Shard[]> shards;
+
+    mutable std::atomic<unsigned long long> lookups{ 0 };
+    mutable std::atomic<unsigned long long> hits{ 0 };
+    mutable std::atomic<unsigned long long> collisions{ 0 };
+    std::atomic<unsigned long long> inserts{ 0 };
+    std::atomic<unsigned long long> evictions{ 0 };
+
+    Shard& shardOf(uint64_t key) const;
+    Slot& slotOf(Shard& shard, uint64_t key) const { return shard.slots[key & (slotsPerShard - 1)]; }
+};
@@ -0,0 +1,700 @@
+﻿#include "GA.h"
+#include "PathUtils.h"
+#include "Fitness.h"
+#include "GraphPruner.h"
+#include "GraphReplicas.h"
+#include "GraphView.h"
+#include "NodeMarks.h"
+#include "Pareto.h"
+
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+static thread_local std::mt19937 rng(std::random_device{}());
+
+static constexpr int POP_SIZE = 120;
+static constexpr int GENERATIONS = 80;
+
+static constexpr int MAX_INIT_TRIES = 5000;
+static constexpr int MAX_EVOLVE_TRIES = 8000;
+
+static constexpr int MAX_RANDOM_LEN = 60;
+
+static constexpr int LOCAL_SEARCH = 4;    // best individuals re-optimized per generation
+static constexpr int LOCAL_WINDOW = 6;    // max extra hops of a re-routed window
+
+static thread_local NodeMarks corridor;
+static thread_local std::vector<int> decodedA;   // decoded genomes
+static thread_local std::vector<int> decodedB;
+
+template <class Objective>
+BasicGA<Objective>::BasicGA(const Graph& g) : graph(g) {}
+
+template <class Objective>
+BasicGA<Objective>::BasicGA(std::shared_ptr<const Graph> snapshot) : pinned(std::move(snapshot)), graph(*pinned) {}
+
+template <class Objective>
+Individual BasicGA<Objective>::runByBlocks(const Graph& g, bool parallel) {
+    std::vector<PrunedGraph> blocks = GraphPruner::splitByBlocks(g);
+    std::vector<std::vector<int>> paths(blocks.size());
+    std::cout << "[GA] Blocks on route: " << blocks.size() << "\n";
+
+    // The blocks are built on this thread, so on a NUMA host their pages sit
+    // on its node. Workers then bind to the nodes round-robin and each solves
+    // on its own copy of the block, first-touched on its node.
+    const int numaNodes = parallel && Numa::localReplicas() ? Numa::nodeCount() : 1;
+
+    auto solve = [&](size_t i) {
+        const Graph& b = blocks[i].graph;
+        // a bridge leaves no choice
+        if (b.edges.size() == 1) { paths[i] = { b.start_node, b.end_node }; return; }
+        Individual piece = numaNodes > 1 ? BasicGA(std::make_shared<const Graph>(b.clone())).run() : BasicGA(b).run();
+        if (piece.fitness < 1e17) paths[i] = std::move(piece.path);
+    };
+
+    if (parallel) {
+        std::atomic<size_t> next{ 0 };
+        size_t workers = std::min(blocks.size(), (size_t)std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> pool;
+        for (size_t w = 0; w < workers; ++w) {
+            pool.emplace_back([&, w] {
+                if (numaNodes > 1) Numa::bindThread((int)(w % (size_t)numaNodes));
+                for (size_t i; (i = next++) < blocks.size();) solve(i);
+            });
+        }
+        for (auto& t : pool) t.join();
+    }
+    else {
+        for (size_t i = 0; i < blocks.size(); ++i) solve(i);
+    }
+
+    Individual best;
+    best.path = GraphPruner::joinBlocks(blocks, paths);
+    if (best.path.empty()) {
+        best.path = { g.start_node };
+        return best;
+    }
+    best.fitness = Fitness::evaluate(g, best.path);
+    return best;
+}
+
+template <class Objective>
+void BasicGA<Objective>::setRoutePolicy(const RoutePolicy& policy) {
+    route = policy.empty() ? RouteCheck() : RouteCheck(graph, policy);
+    restricted = policy.forbidden != 0;
+    if (restricted) {
+        allowed.reset(graph.nodes.size());
+        for (int v = 0; v < graph.nodeCount(); ++v) {
+            if (route.allowed(v)) allowed.set(v);
+        }
+    }
+    cache.clear();
+}
+
+template <class Objective>
+GraphView BasicGA<Objective>::searchView() const {
+    GraphView view(graph);
+    if (restricted) view.nodeMask = &allowed;
+    return view;
+}
+
+template <class Objective>
+double BasicGA<Objective>::routePenalty(const Individual& ind) const {
+    if (!route.active()) return 0.0;
+
+    return RouteCheck::penalty(ind.sums ? route.missing(ind.sums->nodes) : route.missing(ind.start, ind.edges));
+}
+
+template <class Objective>
+double BasicGA<Objective>::evaluate(const Individual& ind) const {
+    double fitness = ind.sums ? Fitness::evaluate(graph, *ind.sums) : Fitness::evaluate(graph, ind.start, ind.edges);
+    return fitness + routePenalty(ind);
+}
+
+template <class Objective>
+double BasicGA<Objective>::score(const Individual& ind) {
+    double fitness;
+    if (memo && cache.find(ind.start, ind.edges, fitness)) return fitness;
+
+    fitness = evaluate(ind);
+    if (memo) cache.insert(ind.start, ind.edges, fitness);
+    return fitness;
+}
+
+template <class Objective>
+bool BasicGA<Objective>::lookup(Individual& ind) const {
+    return memo && cache.find(ind.start, ind.edges, ind.fitness);
+}
+
+template <class Objective>
+std::shared_ptr<const PathSums> BasicGA<Objective>::splice(const Individual& head, size_t keep,
+    const std::vector<int>& middle, const Individual* tail, size_t from) const {
+    if (!incremental || !head.sums) return nullptr;
+    if (tail && !tail->sums) return nullptr;
+
+    auto sums = std::make_shared<PathSums>();
+    if (!Fitness::spliceSums(graph, *head.sums, keep, middle, tail ? tail->sums.get() : nullptr, from, *sums))
+        return nullptr;
+    return sums;
+}
+
+template <class Objective>
+void BasicGA<Objective>::attachSums(Individual& ind) const {
+    if (!incremental || ind.sums) return;
+    auto sums = std::make_shared<PathSums>();
+    if (Fitness::walkSums(graph, ind.start, ind.edges, *sums)) ind.sums = std::move(sums);
+}
+
+template <class Objective>
+const std::vector<int>& BasicGA<Objective>::nodesOf(const Individual& ind, std::vector<int>& scratch) const {
+    if (ind.sums) return ind.sums->nodes;
+    PathUtils::toNodes(graph, ind.start, ind.edges, scratch);
+    return scratch;
+}
+
+// Scores a batch of candidates in one Fitness::evaluateBatch call
+template <class Objective>
+void BasicGA<Objective>::scoreAll(std::vector<Individual>& inds, double cutoff) {
+    // spliced children carry their sums already, the others get them here
+    if (incremental) {
+        for (auto& ind : inds) {
+            if (lookup(ind)) continue;
+            attachSums(ind);
+            ind.fitness = evaluate(ind);
+            if (memo) cache.insert(ind.start, ind.edges, ind.fitness);
+        }
+        return;
+    }
+
+    // known genomes take their cached score, the rest go into the batch
+    batch.clear();
+    batchMisses.clear();
+    for (size_t i = 0; i < inds.size(); ++i) {
+        if (lookup(inds[i])) continue;
+        batch.add(inds[i].start, inds[i].edges);
+        batchMisses.push_back(i);
+    }
+    if (batchMisses.empty()) return;
+
+    // a rejection depends on the cutoff, so it is not cached
+    if (bounded && cutoff < Fitness::REJECTED) {
+        for (size_t i : batchMisses) {
+            Individual& ind = inds[i];
+            ++boundedScored;
+            ind.fitness = Fitness::evaluateBounded(graph, ind.start, ind.edges, cutoff);
+            if (ind.fitness == Fitness::REJECTED) { ++boundedRejected; continue; }
+            if (ind.fitness < 1e17) ind.fitness += routePenalty(ind);
+            if (memo) cache.insert(ind.start, ind.edges, ind.fitness);
+        }
+        return;
+    }
+
+    Fitness::evaluateBatch(graph, batch, batchScores);
+    for (size_t k = 0; k < batchMisses.size(); ++k) {
+        Individual& ind = inds[batchMisses[k]];
+        ind.fitness = batchScores[k];
+        if (batchScores[k] < 1e17) ind.fitness += routePenalty(ind);
+        if (memo) cache.insert(ind.start, ind.edges, ind.fitness);
+    }
+}
+
+template <class Objective>
+bool BasicGA<Objective>::repairCandidate(Individual& ind) {
+    // must start from graph.start_node; otherwise fail and regenerate
+    if (ind.start != graph.start_node) return false;
+
+    // the walk checks every edge continues the path; sums were built by one
+    int tail = ind.sums ? ind.sums->nodes.back() : PathUtils::walkEnd(graph, ind.start, ind.edges);
+    if (tail < 0) return false;
+
+    // ensure ends at end_node
+    if (tail != graph.end_node) {
+        size_t kept = ind.edges.size();
+        if (!PathUtils::repairToEnd(searchView(), tail, ind.edges)) return false;
+        if (ind.sums) ind.sums = splice(ind, kept, std::vector<int>(ind.edges.begin() + (std::ptrdiff_t)kept, ind.edges.end()));
+    }
+
+    return true;
+}
+
+template <class Objective>
+Individual BasicGA<Objective>::run() {
+    std::cout << "[GA] Starting genetic algorithm...\n";
+    std::cout << "[GA] Start=" << graph.nodes[graph.start_node].id
+        << " End=" << graph.nodes[graph.end_node].id << "\n";
+
+    // Quick check: does any path exist at all (around forbidden nodes)?
+    auto bfs = PathUtils::bfsPath(searchView());
+    if (bfs.empty()) {
+        std::cout << "[GA] ERROR: No path exists between start and end"
+            << (restricted ? " around the forbidden node types" : "") << " (BFS failed).\n";
+        Individual fail;
+        fail.start = graph.start_node;
+        fail.path = { graph.start_node };
+        fail.fitness = 1e18;
+        return fail;
+    }
+
+    initPopulation();
+    best = population.front();
+
+    for (int gen = 0; gen < GENERATIONS; ++gen) {
+        evolve();
+
+        for (const auto& ind : population) {
+            if (ind.fitness < best.fitness) best = ind;
+        }
+
+        std::cout << "[GEN " << gen << "] Best fitness: " << best.fitness
+            << " | Path len: " << best.edges.size() + 1 << "\n";
+    }
+
+    if (memo) {
+        FitnessCacheStats stats = cache.stats();
+        std::cout << "[GA] Fitness cache: " << stats.hits << " of " << stats.lookups
+            << " lookups hit (" << 100.0 * stats.hitRate() << "%), "
+            << stats.collisions << " collisions, " << stats.evictions << " evictions\n";
+    }
+    if (bounded && !incremental) {
+        std::cout << "[GA] Bounded fitness: " << boundedRejected << " of " << boundedScored
+            << " children rejected early\n";
+    }
+
+    // spliced sums round differently in the last bits; report the plain score
+    if (incremental) best.fitness = Fitness::evaluate(graph, best.start, best.edges) + routePenalty(best);
+
+    if (fullPrecisionCheck && graph.isQuantized()) {
+        double exact = Fitness::evaluateExact(graph, best.start, best.edges) + routePenalty(best);
+        std::cout << "[GA] Full-precision check: " << best.fitness << " -> " << exact << "\n";
+        best.fitness = exact;
+    }
+
+    PathUtils::toNodes(graph, best.start, best.edges, best.path);
+    return best;
+}
+
+template <class Objective>
+void BasicGA<Objective>::initPopulation() {
+    population.clear();
+    population.reserve(POP_SIZE);
+    const GraphView view = searchView();
+
+    // Always seed with BFS shortest path (guaranteed baseline: run() checked
+    // it exists), i.e. the repair of an empty walk
+    {
+        Individual ind;
+        ind.start = graph.start_node;
+        PathUtils::repairToEnd(view, ind.start, ind.edges);
+        attachSums(ind);
+        ind.fitness = score(ind);
+        population.push_back(ind);
+    }
+
+    // ...and with the cheapest path by this objective's per-hop cost
+    {
+        Individual ind;
+        ind.start = graph.start_node;
+        if (PathUtils::cheapestEdges<Objective>(view, ind.edges)) {
+            attachSums(ind);
+            ind.fitness = score(ind);
+            if (ind.fitness < 1e17) population.push_back(ind);
+        }
+    }
+
+    // random walks for the open slots, scored a batch at a time
+    int tries = 0;
+    std::vector<Individual> fresh;
+    while ((int)population.size() < POP_SIZE && tries < MAX_INIT_TRIES) {
+        fresh.clear();
+        while ((int)(population.size() + fresh.size()) < POP_SIZE && tries < MAX_INIT_TRIES) {
+            ++tries;
+
+            auto path = PathUtils::randomPath(view, MAX_RANDOM_LEN);
+            if (path.empty()) continue;
+
+            Individual ind;
+            ind.start = path.front();
+            if (!PathUtils::toEdges(view, path, ind.edges)) continue;
+            if (!repairCandidate(ind)) continue;
+
+            fresh.push_back(std::move(ind));
+        }
+
+        scoreAll(fresh);
+        for (auto& ind : fresh) {
+            if (ind.fitness < 1e17) population.push_back(std::move(ind));
+        }
+    }
+
+    // If still too small — duplicate best-ish
+    while ((int)population.size() < POP_SIZE) {
+        population.push_back(population[rng() % population.size()]);
+    }
+
+    // sort by fitness
+    std::sort(population.begin(), population.end(),
+        [](const Individual& a, const Individual& b) { return a.fitness < b.fitness; });
+
+    std::cout << "[GA] Initial population: " << population.size()
+        << " | Best seed fitness: " << population.front().fitness << "\n";
+}
+
+static const Individual& tournamentPick(const std::vector<Individual>& pop, int k) {
+    const Individual* best = nullptr;
+    for (int i = 0; i < k; ++i) {
+        const Individual& cand = pop[rng() % pop.size()];
+        if (!best || cand.fitness < best->fitness) best = &cand;
+    }
+    return *best;
+}
+
+template <class Objective>
+void BasicGA<Objective>::evolve() {
+    std::vector<Individual> next;
+    next.reserve(POP_SIZE);
+
+    // Elitism: keep top N
+    const int ELITE = 8;
+    for (int i = 0; i < ELITE && i < (int)population.size(); ++i) {
+        next.push_back(population[i]);
+    }
+
+    // breed the open slots, then score the whole brood in one call.
+    // With bounded fitness, children that can't beat this generation's
+    // worst are rejected and their slots go to the fill below, copies of
+    // the current population, where the plain GA would keep them
+    const double cutoff = bounded && !incremental ? population.back().fitness : Fitness::REJECTED;
+    int tries = 0;
+    int rejected = 0;
+    std::vector<Individual> children;
+    while ((int)next.size() + rejected < POP_SIZE && tries < MAX_EVOLVE_TRIES) {
+        children.clear();
+        while ((int)next.size() + rejected + (int)children.size() < POP_SIZE && tries < MAX_EVOLVE_TRIES) {
+            ++tries;
+
+            const Individual& a = tournamentPick(population, 5);
+            const Individual& b = tournamentPick(population, 5);
+
+            Individual child = crossover(a, b);
+            mutate(child);
+
+            // only complete, scored genomes are cached: a known one needs
+            // neither the repair nor a score
+            if (lookup(child)) {
+                if (child.fitness < 1e17) next.push_back(std::move(child));
+                continue;
+            }
+            if (!repairCandidate(child)) continue;
+            children.push_back(std::move(child));
+        }
+
+        scoreAll(children, cutoff);
+        for (auto& child : children) {
+            if (child.fitness < 1e17) next.push_back(std::move(child));
+            else if (child.fitness == Fitness::REJECTED) ++rejected;
+        }
+    }
+
+    // fill if needed
+    while ((int)next.size() < POP_SIZE) {
+        next.push_back(population[rng() % population.size()]);
+    }
+
+    // local re-routing of the front runners
+    std::sort(next.begin(), next.end(),
+        [](const Individual& x, const Individual& y) { return x.fitness < y.fitness; });
+    for (int i = 0; i < LOCAL_SEARCH && i < (int)next.size(); ++i) localSearch(next[(size_t)i]);
+
+    // re-sort
+    std::sort(next.begin(), next.end(),
+        [](const Individual& x, const Individual& y) { return x.fitness < y.fitness; });
+
+    population = std::move(next);
+}
+
+// Re-routes a random window of the path by the cheapest route inside the
+// corridor of the window nodes and their neighbors. The corridor is a
+// masked view of the graph, so nothing is copied.
+template <class Objective>
+void BasicGA<Objective>::localSearch(Individual& ind) {
+    if (ind.edges.size() < 2) return;
+    const std::vector<int>& path = nodesOf(ind, decodedA);
+
+    size_t i = rng() % (path.size() - 2);
+    size_t j = std::min(path.size() - 1, i + 2 + rng() % LOCAL_WINDOW);
+
+    corridor.reset(graph.nodes.size());
+    for (size_t k = i; k <= j; ++k) {
+        corridor.set(path[k]);
+        for (int u : graph.neighbors(path[k])) {
+            if (!restricted || allowed.test(u)) corridor.set(u);
+        }
+    }
+    // the rest of the path stays out, so the splice doesn't revisit it
+    for (size_t k = 0; k < path.size(); ++k) {
+        if (k < i || k > j) corridor.unset(path[k]);
+    }
+    corridor.set(path[i]);
+    corridor.set(path[j]);
+
+    GraphView view(graph);
+    view.nodeMask = &corridor;
+    view.start_node = path[i];
+    view.end_node = path[j];
+    std::vector<int> segment;
+    if (!PathUtils::cheapestEdges<Objective>(view, segment) || segment.empty()) return;
+
+    // node k of the path is reached after edge k - 1
+    Individual cand;
+    cand.start = ind.start;
+    cand.edges.reserve(ind.edges.size() + segment.size());
+    cand.edges.insert(cand.edges.end(), ind.edges.begin(), ind.edges.begin() + (std::ptrdiff_t)i);
+    cand.edges.insert(cand.edges.end(), segment.begin(), segment.end());
+    cand.edges.insert(cand.edges.end(), ind.edges.begin() + (std::ptrdiff_t)j, ind.edges.end());
+    cand.sums = splice(ind, i, segment, &ind, j);
+    cand.fitness = score(cand);
+    if (cand.fitness < ind.fitness) ind = std::move(cand);
+}
+
+// Crossover: splice at a common node (more valid than random cut)
+// If no common node -> take prefix of A then repair to end.
+// The genomes are decoded to their nodes only to find the splice point.
+// With running sums the child's are spliced from the parents'.
+template <class Objective>
+Individual BasicGA<Objective>::crossover(const Individual& a, const Individual& b) {
+    Individual child;
+    child.start = a.start;
+
+    if (a.edges.empty()) return a;
+    if (b.edges.empty()) return a;
+
+    const std::vector<int>& nodesA = nodesOf(a, decodedA);
+    const std::vector<int>& nodesB = nodesOf(b, decodedB);
+
+    // Collect common nodes excluding endpoints
+    std::vector<int> common;
+    common.reserve(16);
+
+    for (size_t i = 1; i + 1 < nodesA.size(); ++i) {
+        int v = nodesA[i];
+        // quick search in b
+        if (std::find(nodesB.begin() + 1, nodesB.end() - 1, v) != (nodesB.end() - 1)) {
+            common.push_back(v);
+        }
+    }
+
+    if (!common.empty()) {
+        int pivot = common[rng() % common.size()];
+
+        // A up to the pivot, then B from it
+        auto ia = std::find(nodesA.begin(), nodesA.end(), pivot) - nodesA.begin();
+        auto ib = std::find(nodesB.begin(), nodesB.end(), pivot) - nodesB.begin();
+
+        child.edges.insert(child.edges.end(), a.edges.begin(), a.edges.begin() + ia);
+        child.edges.insert(child.edges.end(), b.edges.begin() + ib, b.edges.end());
+        child.sums = splice(a, (size_t)ia, {}, &b, (size_t)ib);
+    }
+    else {
+        // fallback: take a prefix of A (repairCandidate fixes it)
+        size_t cut = rng() % a.edges.size();
+        child.edges.insert(child.edges.end(), a.edges.begin(), a.edges.begin() + (std::ptrdiff_t)cut);
+        child.sums = splice(a, cut, {});
+    }
+
+    return child;
+}
+
+template <class Objective>
+void BasicGA<Objective>::mutate(Individual& ind) {
+    if (ind.edges.size() < 2) return;
+
+    // Mutate with probability
+    if ((rng() % 100) >= 35) return;
+
+    // Strategy A: cut the walk at a random inner node and repair from there
+    if ((rng() % 100) < 70) {
+        size_t cut = 1 + (rng() % (ind.edges.size() - 1));
+        ind.edges.resize(cut);
+        int tail = ind.sums ? ind.sums->nodes[cut] : PathUtils::walkEnd(graph, ind.start, ind.edges);
+        PathUtils::repairToEnd(searchView(), tail, ind.edges);
+        ind.sums = splice(ind, cut, std::vector<int>(ind.edges.begin() + (std::ptrdiff_t)cut, ind.edges.end()));
+        return;
+    }
+
+    // Strategy B: swap two edges, keep the walk up to the first edge that
+    // no longer continues it, then repair
+    size_t i = rng() % ind.edges.size();
+    size_t j = rng() % ind.edges.size();
+    if (i == j) return;
+    std::swap(ind.edges[i], ind.edges[j]);
+    ind.sums.reset();
+
+    int cur = ind.start;
+    size_t k = 0;
+    for (; k < ind.edges.size(); ++k) {
+        int next = graph.across(ind.edges[k], cur);
+        if (next < 0) break;
+        cur = next;
+    }
+    if (k == ind.edges.size()) return;
+    ind.edges.resize(k);
+    PathUtils::repairToEnd(searchView(), cur, ind.edges);
+}
+
+template <class Objective>
+bool BasicGA<Objective>::measure(Individual& ind, const std::vector<Criterion>& criteria) const {
+    PathTotals t;
+    if (!Fitness::walkTotals(graph, ind.start, ind.edges, t) || t.loops > 0) return false;
+    if (route.active() && route.missing(ind.start, ind.edges) != 0) return false;
+
+    ind.criteria.resize(criteria.size());
+    for (size_t k = 0; k < criteria.size(); ++k) {
+        switch (criteria[k]) {
+        case Criterion::Latency: ind.criteria[k] = t.latency; break;
+        case Criterion::Hops: ind.criteria[k] = (double)(t.nodes - 1); break;
+        case Criterion::Bandwidth: ind.criteria[k] = t.penalty; break;
+        case Criterion::Performance: ind.criteria[k] = PerfTerm<1>::value(t); break;
+        }
+    }
+    return true;
+}
+
+// Binary tournament on (front, crowding distance)
+static size_t crowdedPick(const std::vector<int>& ranks, const std::vector<double>& crowd) {
+    size_t a = rng() % ranks.size();
+    size_t b = rng() % ranks.size();
+    if (ranks[a] != ranks[b]) return ranks[a] < ranks[b] ? a : b;
+    return crowd[a] >= crowd[b] ? a : b;
+}
+
+// Fronts and crowding distances of a population
+static void rankAndCrowd(const std::vector<Individual>& pop, size_t m,
+    std::vector<int>& ranks, std::vector<double>& crowd) {
+    std::vector<double> values;
+    values.reserve(pop.size() * m);
+    for (const auto& ind : pop) values.insert(values.end(), ind.criteria.begin(), ind.criteria.end());
+    ranks = ParetoSort::rank(values, m);
+    crowd = ParetoSort::crowding(values, m, ranks);
+}
+
+template <class Objective>
+std::vector<Individual> BasicGA<Objective>::runPareto(const std::vector<Criterion>& criteria, int popSize) {
+    if (criteria.empty()) throw std::runtime_error("GA: runPareto needs at least one criterion");
+    const size_t n = popSize > 0 ? (size_t)popSize : (size_t)POP_SIZE;
+    const size_t m = criteria.size();
+    const int maxTries = std::max(MAX_EVOLVE_TRIES, 60 * (int)n);
+
+    std::cout << "[GA] Starting multi-objective search: " << m << " criteria, population " << n << "\n";
+
+    // seeds as in the scalar run, then repaired random walks
+    std::vector<Individual> pop;
+    pop.reserve(2 * n);
+    const GraphView view = searchView();
+    {
+        Individual shortest;
+        shortest.start = graph.start_node;
+        if (PathUtils::repairToEnd(view, shortest.start, shortest.edges) && measure(shortest, criteria))
+            pop.push_back(std::move(shortest));
+
+        Individual cheapest;
+        cheapest.start = graph.start_node;
+        if (PathUtils::cheapestEdges<Objective>(view, cheapest.edges) && measure(cheapest, criteria))
+            pop.push_back(std::move(cheapest));
+    }
+    if (pop.empty()) {
+        std::cout << "[GA] ERROR: No loop-free path within the route policy.\n";
+        return {};
+    }
+
+    int tries = 0;
+    while (pop.size() < n && tries < maxTries) {
+        ++tries;
+        auto path = PathUtils::randomPath(view, MAX_RANDOM_LEN);
+        if (path.empty()) continue;
+
+        Individual ind;
+        ind.start = path.front();
+        if (!PathUtils::toEdges(view, path, ind.edges)) continue;
+        if (!repairCandidate(ind) || !measure(ind, criteria)) continue;
+        pop.push_back(std::move(ind));
+    }
+    while (pop.size() < n) pop.push_back(pop[rng() % pop.size()]);
+
+    std::vector<int> ranks;
+    std::vector<double> crowd;
+    rankAndCrowd(pop, m, ranks, crowd);
+
+    std::vector<size_t> order;
+    for (int gen = 0; gen < GENERATIONS; ++gen) {
+        // offspring next to their parents, then the best n of both survive
+        tries = 0;
+        const size_t parents = pop.size();
+        while (pop.size() < parents + n && tries < maxTries) {
+            ++tries;
+            const Individual& a = pop[crowdedPick(ranks, crowd)];
+            const Individual& b = pop[crowdedPick(ranks, crowd)];
+
+            Individual child = crossover(a, b);
+            mutate(child);
+            if (!repairCandidate(child) || !measure(child, criteria)) continue;
+            pop.push_back(std::move(child));
+        }
+
+        // copies would share a front and crowd out the rest of it
+        std::sort(pop.begin(), pop.end(),
+            [](const Individual& x, const Individual& y) { return x.criteria < y.criteria; });
+        pop.erase(std::unique(pop.begin(), pop.end(),
+            [](const Individual& x, const Individual& y) { return x.criteria == y.criteria; }), pop.end());
+
+        // whole fronts while they fit, the last one by crowding distance
+        rankAndCrowd(pop, m, ranks, crowd);
+        order.resize(pop.size());
+        std::iota(order.begin(), order.end(), (size_t)0);
+        std::sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+            if (ranks[x] != ranks[y]) return ranks[x] < ranks[y];
+            return crowd[x] > crowd[y];
+        });
+        order.resize(std::min(order.size(), n));
+
+        std::vector<Individual> next;
+        std::vector<int> nextRanks;
+        std::vector<double> nextCrowd;
+        next.reserve(2 * n);
+        for (size_t i : order) {
+            next.push_back(std::move(pop[i]));
+            nextRanks.push_back(ranks[i]);
+            nextCrowd.push_back(crowd[i]);
+        }
+        pop = std::move(next);
+        ranks = std::move(nextRanks);
+        crowd = std::move(nextCrowd);
+
+        size_t front = (size_t)std::count(ranks.begin(), ranks.end(), 0);
+        std::cout << "[PARETO GEN " << gen << "] Front size: " << front << "\n";
+    }
+
+    // the first front; its members are distinct already
+    std::vector<Individual> front;
+    for (size_t i = 0; i < pop.size(); ++i) {
+        if (ranks[i] == 0) front.push_back(std::move(pop[i]));
+    }
+    std::sort(front.begin(), front.end(),
+        [](const Individual& x, const Individual& y) { return x.criteria < y.criteria; });
+
+    for (auto& ind : front) {
+        ind.sums.reset();
+        ind.fitness = evaluate(ind);
+        PathUtils::toNodes(graph, ind.start, ind.edges, ind.path);
+    }
+    std::cout << "[GA] Pareto front: " << front.size() << " paths\n";
+    return front;
+}
+
+#define OPTNET_INSTANTIATE_GA(Objective, name) template class BasicGA<Objective>;
+
+OPTNET_OBJECTIVES(OPTNET_INSTANTIATE_GA)
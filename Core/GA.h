@@ -0,0 +1,147 @@
+﻿#pragma once
+#include "Fitness.h"
+#include "FitnessCache.h"
+#include "Graph.h"
+#include "GraphView.h"
+#include "Individual.h"
+#include "NodeMarks.h"
+#include "RoutePolicy.h"
+#include <memory>
+#include <vector>
+
+// Criteria of the multi-objective mode (GA::runPareto), all minimized
+enum class Criterion {
+    Latency,       // summed hop latency
+    Hops,
+    Bandwidth,     // summed latency / bandwidth
+    Performance    // the performance bonus of PerfTerm, negated
+};
+
+// Genetic path search minimizing BasicFitness<Objective> (Objective.h).
+// Defined in GA.cpp for each of OPTNET_OBJECTIVES; ObjectiveRegistry picks
+// one by name at run time.
+template <class Objective>
+class BasicGA {
+public:
+    using Fitness = BasicFitness<Objective>;
+
+    explicit BasicGA(const Graph& g);
+
+    // Runs on a pinned GraphStore snapshot and keeps it alive meanwhile
+    explicit BasicGA(std::shared_ptr<const Graph> snapshot);
+
+    Individual run();
+
+    // Multi-objective mode (NSGA-II): one run evolves a population of
+    // popSize (0: the scalar run's) towards the Pareto front over the
+    // criteria, ranked by ParetoSort and spread by crowding distance.
+    // Walks that revisit a node or break the route policy are left out.
+    // Returns the non-dominated paths, decoded, by their first criterion,
+    // each with its values in Individual::criteria and its objective score
+    // as fitness.
+    std::vector<Individual> runPareto(
+        const std::vector<Criterion>& criteria = { Criterion::Latency, Criterion::Bandwidth, Criterion::Hops },
+        int popSize = 0);
+
+    // Candidates through a forbidden node type are dropped; each required
+    // type a path misses adds RouteCheck::MISSING_TYPE_PENALTY to its fitness. Seeding,
+    // repair and local search route around the forbidden nodes.
+    void setRoutePolicy(const RoutePolicy& policy);
+
+    // Scores are memoized by genome (FitnessCache.h), so elites, duplicates
+    // and children rebuilding a known path are neither repaired nor scored
+    // again (default on)
+    void setFitnessCache(bool on) { memo = on; }
+    FitnessCacheStats cacheStats() const { return cache.stats(); }
+
+    // Children carry running sums (Individual::sums) and are scored from
+    // what they inherit plus their new segment instead of from scratch.
+    // Pays off on long paths (hundreds of hops); default off, children are
+    // then scored in batches.
+    void setIncrementalFitness(bool on) { incremental = on; }
+
+    // Children are scored against a cutoff, the previous generation's worst
+    // fitness (Fitness::evaluateBounded): one that can't beat it is
+    // rejected part way and its slot gets a copy of a random member of the
+    // previous generation. Unbounded, such a child would survive at the
+    // bottom, so this is a truncation step the plain GA doesn't have
+    // (optnet_bench evolve compares the two). Path by path instead of in
+    // batches, and only without incremental fitness, which scores in O(1)
+    // anyway (default off)
+    void setBoundedFitness(bool on) { bounded = on; }
+
+    // On a quantized graph, re-score the final best in full precision (default on)
+    void setFullPrecisionCheck(bool on) { fullPrecisionCheck = on; }
+
+    // Solves each biconnected block on the start->end block path as its own
+    // problem (on a worker pool if parallel) and joins the pieces. The
+    // hop terms of the fitness add up across blocks, the performance average
+    // does not, so this trades a little optimality for a smaller search.
+    // Parallel workers use NUMA-local copies, see Numa::setLocalReplicas.
+    // The returned fitness is for the joined path on g.
+    static Individual runByBlocks(const Graph& g, bool parallel = true);
+
+private:
+    std::shared_ptr<const Graph> pinned;   // set when built from a snapshot
+    const Graph& graph;
+    std::vector<Individual> population;
+    Individual best;
+    bool fullPrecisionCheck = true;
+    bool incremental = false;
+    bool memo = true;
+    bool bounded = false;
+    unsigned long long boundedScored = 0;     // children scored against a cutoff
+    unsigned long long boundedRejected = 0;
+    RouteCheck route;
+    NodeMarks allowed;                // nodes the route policy doesn't forbid
+    bool restricted = false;          // some node is forbidden
+    FitnessCache cache;
+    PathBatch batch;                  // scratch of scoreAll
+    std::vector<double> batchScores;
+    std::vector<size_t> batchMisses;  // which candidates the batch holds
+
+    // The graph as the path searches of seeding and repair see it: without
+    // the nodes the route policy forbids
+    GraphView searchView() const;
+
+    void initPopulation();
+    void evolve();
+
+    Individual crossover(const Individual& a, const Individual& b);
+    void mutate(Individual& ind);
+    void localSearch(Individual& ind);
+
+    // route policy penalty of a genome; 1e18 if the policy rejects it
+    double routePenalty(const Individual& ind) const;
+    double evaluate(const Individual& ind) const;   // fitness + routePenalty
+    double score(const Individual& ind);            // evaluate() through the cache
+
+    // Cached score of ind, if any
+    bool lookup(Individual& ind) const;
+
+    // Fitness of every candidate the cache doesn't know through one
+    // evaluateBatch call, or from their running sums when incremental.
+    // With bounded fitness and a finite cutoff, those that can't score
+    // cutoff or less come back as Fitness::REJECTED.
+    void scoreAll(std::vector<Individual>& inds, double cutoff = Fitness::REJECTED);
+
+    // Running sums of a child that keeps head's first `keep` edges, walks the
+    // new `middle` edges and then follows tail from its node `from`; null
+    // unless incremental and the parents have sums
+    std::shared_ptr<const PathSums> splice(const Individual& head, size_t keep,
+        const std::vector<int>& middle, const Individual* tail = nullptr, size_t from = 0) const;
+
+    // Computes the running sums of ind from scratch if incremental and missing
+    void attachSums(Individual& ind) const;
+
+    // Node sequence of ind: its sums if it has them, else decoded into scratch
+    const std::vector<int>& nodesOf(const Individual& ind, std::vector<int>& scratch) const;
+
+    // helper: repair so the walk is valid and ends at end_node
+    bool repairCandidate(Individual& ind);
+
+    // Fills ind.criteria; false if the walk loops or the route policy rejects it
+    bool measure(Individual& ind, const std::vector<Criterion>& criteria) const;
+};
+
+using GA = BasicGA<DefaultObjective>;
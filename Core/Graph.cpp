@@ -0,0 +1,136 @@
+﻿#include "Graph.h"
+#include "GraphBuilder.h"
+#include "NodeTypeIndex.h"
+#include "Fitness.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+void Graph::buildAdjacency(int threads, bool compressed) {
+    GraphBuilder::buildAdjacency(*this, threads, compressed);
+    indexNodeTypes();
+    precomputeCosts();
+}
+
+void Graph::indexNodeTypes() {
+    types = std::make_shared<const NodeTypeIndex>(NodeTypeIndex::build(nodes));
+}
+
+void Graph::precomputeCosts() {
+    const size_t m = edges.size();
+    const bool columns = !packed;
+    hopTerms.clear();
+    hopCost.clear();
+    if (columns) {
+        hopTerms.reserve(m);
+        hopCost.reserve(m);
+    }
+    hopFloor = m ? HopTerms{ std::numeric_limits<double>::max(), std::numeric_limits<double>::max() } : HopTerms{};
+    for (size_t id = 0; id < m; ++id) {
+        double latency = (double)edges.latency[id];
+        double bandwidth = (double)edges.bandwidth[id];
+        HopTerms hop = HopTerms::of(latency, bandwidth);
+        if (columns) {
+            hopTerms.push_back(hop);
+            hopCost.push_back(Fitness::hopCost(latency, bandwidth));
+        }
+        hopFloor.latency = std::min(hopFloor.latency, hop.latency);
+        hopFloor.penalty = std::min(hopFloor.penalty, hop.penalty);
+    }
+
+    AlignedVector<double> perf(nodes.size());
+    perfCeiling = 0.0;
+    for (size_t v = 0; v < nodes.size(); ++v) {
+        perf[v] = (double)nodes[v].performance;
+        perfCeiling = std::max(perfCeiling, perf[v]);
+    }
+    nodePerf = std::move(perf);
+}
+
+int Graph::findEdge(int a, int b) const {
+    if (!hasNode(a) || !hasNode(b)) return -1;
+    if (packed) {
+        // rows are sorted by target: stop at the first one not below b
+        NeighborCursor c = cursor(a);
+        while (c.next()) {
+            if (c.target == b) return c.edge;
+            if (c.target > b) break;
+        }
+        return -1;
+    }
+    const int* first = adjTargets.data() + adjOffsets[a];
+    const int* last = adjTargets.data() + adjOffsets[a + 1];
+    const int* it = std::lower_bound(first, last, b);
+    if (it == last || *it != b) return -1;
+    return adjEdges[(size_t)(it - adjTargets.data())];
+}
+
+void Graph::setEdgeWeights(int id, double latency, double bandwidth) {
+    edges.latency.set((size_t)id, (weight_t)latency);
+    edges.bandwidth.set((size_t)id, (weight_t)bandwidth);
+
+    // from the stored (possibly float) weights, like precomputeCosts
+    double lat = (double)edges.latency[(size_t)id];
+    double bw = (double)edges.bandwidth[(size_t)id];
+    HopTerms hop = HopTerms::of(lat, bw);
+    hopFloor.latency = std::min(hopFloor.latency, hop.latency);
+    hopFloor.penalty = std::min(hopFloor.penalty, hop.penalty);
+    if (hasHopColumns()) {
+        hopTerms.set((size_t)id, hop);
+        hopCost.set((size_t)id, Fitness::hopCost(lat, bw));
+    }
+    quantized.reset();
+}
+
+double Graph::computeCost(size_t id) const {
+    return Fitness::hopCost((double)edges.latency[id], (double)edges.bandwidth[id]);
+}
+
+void Graph::compressAdjacency() {
+    if (packed) return;
+    packed = std::make_shared<const CompressedAdjacency>(CompressedAdjacency::fromCsr(
+        nodes.size(), adjOffsets.data(), adjTargets.data(), adjEdges.data()));
+    adjOffsets = AlignedVector<int>();
+    adjTargets = AlignedVector<int>();
+    adjEdges = AlignedVector<int>();
+    hopTerms.clear();
+    hopCost.clear();
+}
+
+void Graph::quantizeWeights() {
+    quantized = std::make_shared<const QuantizedWeights>(QuantizedWeights::fromEdges(edges));
+}
+
+size_t Graph::adjacencyBytes() const {
+    if (packed) return packed->bytes();
+    return (adjOffsets.size() + adjTargets.size() + adjEdges.size()) * sizeof(int);
+}
+
+size_t Graph::bytes() const {
+    return nodes.size() * sizeof(Node)
+        + (edges.node_a.size() + edges.node_b.size()) * sizeof(int)
+        + edges.latency.bytes() + edges.bandwidth.bytes()
+        + adjacencyBytes()
+        + hopTerms.bytes() + hopCost.bytes() + nodePerf.size() * sizeof(double)
+        + (quantized ? quantized->bytes() : 0)
+        + (types ? types->bytes() : 0);
+}
+
+Graph Graph::clone() const {
+    Graph c = *this;
+    c.nodes.unshare();
+    c.edges.node_a.unshare();
+    c.edges.node_b.unshare();
+    c.edges.latency.unshare();
+    c.edges.bandwidth.unshare();
+    c.hopTerms.unshare();
+    c.hopCost.unshare();
+    c.nodePerf.unshare();
+    c.adjOffsets.unshare();
+    c.adjTargets.unshare();
+    c.adjEdges.unshare();
+    if (packed) c.packed = std::make_shared<const CompressedAdjacency>(*packed);
+    if (quantized) c.quantized = std::make_shared<const QuantizedWeights>(*quantized);
+    if (types) c.types = std::make_shared<const NodeTypeIndex>(*types);
+    return c;
+}
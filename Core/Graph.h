@@ -0,0 +1,310 @@
+﻿#pragma once
+#include "CowArray.h"
+#include "CompressedAdjacency.h"
+#include "QuantizedWeights.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+// Storage type of the edge weight columns. OPTNET_FLOAT32_WEIGHTS halves
+// the bytes streamed per hop; inputs and scores stay double.
+#ifdef OPTNET_FLOAT32_WEIGHTS
+using weight_t = float;
+#else
+using weight_t = double;
+#endif
+
+// OPTNET_COMPACT_GRAPH is the low-memory build (it also sets
+// OPTNET_FLOAT32_WEIGHTS): adjacency is built as varint rows unless asked
+// otherwise, so no hop cost columns are kept either (see Graph::hopTerms)
+#ifdef OPTNET_COMPACT_GRAPH
+inline constexpr bool COMPACT_GRAPH = true;
+#else
+inline constexpr bool COMPACT_GRAPH = false;
+#endif
+
+enum class NodeType {
+    PC,
+    COMPUTE,
+    SERVER,
+    STORAGE,
+    GATEWAY,
+    UNKNOWN
+};
+
+struct Node {
+    int id = 0;               // id as written in the input file
+    int performance = 0;
+    NodeType type = NodeType::UNKNOWN;
+};
+
+class NodeTypeIndex;
+
+// The two per-hop sums of Fitness::evaluate for one edge
+struct HopTerms {
+    double latency = 0.0;   // max(0.001, latency)
+    double penalty = 0.0;   // max(0.001, latency) / max(0.001, bandwidth)
+
+    static HopTerms of(double latency, double bandwidth) {
+        double lat = latency > 0.001 ? latency : 0.001;
+        return { lat, lat / (bandwidth > 0.001 ? bandwidth : 0.001) };
+    }
+};
+
+// One edge as a value (parsing, generation, export). The graph itself
+// stores edges column-wise, see EdgeList.
+struct Edge {
+    int node_a = 0;           // dense node index
+    int node_b = 0;           // dense node index
+    double latency = 1.0;     // ms-ish
+    double bandwidth = 1.0;   // arbitrary units
+};
+
+// Structure-of-arrays edge storage: one aligned column per field, indexed
+// by edge id, so a kernel touches only the columns it reads. Endpoints are
+// fixed topology; the weight columns are paged so live updates copy only
+// the pages they touch.
+struct EdgeList {
+    CowVector<int> node_a;
+    CowVector<int> node_b;
+    PagedColumn<weight_t> latency;
+    PagedColumn<weight_t> bandwidth;
+
+    size_t size() const { return node_a.size(); }
+    bool empty() const { return node_a.empty(); }
+
+    void reserve(size_t n) {
+        node_a.reserve(n);
+        node_b.reserve(n);
+        latency.reserve(n);
+        bandwidth.reserve(n);
+    }
+
+    void clear() {
+        node_a.clear();
+        node_b.clear();
+        latency.clear();
+        bandwidth.clear();
+    }
+
+    void push_back(const Edge& e) {
+        node_a.push_back(e.node_a);
+        node_b.push_back(e.node_b);
+        latency.push_back((weight_t)e.latency);
+        bandwidth.push_back((weight_t)e.bandwidth);
+    }
+
+    Edge operator[](size_t id) const {
+        return { node_a[id], node_b[id], (double)latency[id], (double)bandwidth[id] };
+    }
+};
+
+// Walks the (neighbor, edge id) pairs of one node on either adjacency
+// backend: plain CSR arrays or CompressedAdjacency rows
+class NeighborCursor {
+public:
+    int target = -1;
+    int edge = -1;
+
+    bool next() {
+        if (p) {
+            if (p == pEnd) return false;
+            target += (int)Varint::unzigzag(Varint::get(p));
+            edge += (int)Varint::unzigzag(Varint::get(p));
+            return true;
+        }
+        if (t == tEnd) return false;
+        target = *t++;
+        edge = *e++;
+        return true;
+    }
+
+private:
+    friend struct Graph;
+    friend struct NeighborRange;
+
+    const int* t = nullptr;        // CSR
+    const int* tEnd = nullptr;
+    const int* e = nullptr;
+    const uint8_t* p = nullptr;    // compressed
+    const uint8_t* pEnd = nullptr;
+};
+
+// Neighbors of one node, usable with range-for on both backends
+struct NeighborRange {
+    class iterator {
+    public:
+        explicit iterator(const NeighborCursor& c) : cur(c) { done = !cur.next(); }
+        iterator() = default;
+
+        int operator*() const { return cur.target; }
+        int edge() const { return cur.edge; }
+        iterator& operator++() { done = !cur.next(); return *this; }
+        // only meant for comparison against end()
+        bool operator!=(const iterator& other) const { return done != other.done; }
+
+    private:
+        NeighborCursor cur;
+        bool done = true;
+    };
+
+    NeighborCursor start;
+    int count = 0;
+
+    iterator begin() const { return iterator(start); }
+    iterator end() const { return iterator(); }
+    size_t size() const { return (size_t)count; }
+    bool empty() const { return count == 0; }
+
+    // k-th neighbor: O(1) on CSR, O(k) decode on the compressed backend, so
+    // list a compressed row once (a cursor walk) before picking by index
+    int operator[](size_t k) const {
+        if (!start.p) return start.t[k];
+        NeighborCursor c = start;
+        for (size_t i = 0; i <= k; ++i) c.next();
+        return c.target;
+    }
+};
+
+// Copying a Graph is cheap: all arrays are shared copy-on-write (CowArray.h)
+struct Graph {
+    // Nodes are stored densely: the position in this vector (0..N-1) is the
+    // index used everywhere in the solver, Node::id keeps the original id.
+    CowVector<Node> nodes;
+    EdgeList edges;
+
+    // for GA (dense indices)
+    int start_node = 0;
+    int end_node = 0;
+
+    // CSR adjacency, built once by buildAdjacency():
+    // neighbors of v are adjTargets[adjOffsets[v] .. adjOffsets[v + 1]),
+    // each row sorted by target; adjEdges holds the matching edge ids
+    CowVector<int> adjOffsets;
+    CowVector<int> adjTargets;
+    CowVector<int> adjEdges;
+
+    // Optional compressed backend (buildAdjacency(threads, true) or
+    // compressAdjacency()). When set, the CSR arrays above are empty and all
+    // neighbor access decodes from here, and the hop cost columns below are
+    // not kept. With float weights that is about 21 bytes per edge in all.
+    std::shared_ptr<const CompressedAdjacency> packed;
+
+    // Optional 16-bit weights (quantizeWeights()). When set, Fitness scores
+    // from these; the full-precision columns above stay authoritative.
+    std::shared_ptr<const QuantizedWeights> quantized;
+
+    // Per-edge hop terms of the fitness, from the weight columns with the
+    // 0.001 clamps applied (precomputeCosts()): latency and latency/bandwidth
+    // side by side, so a hop is one load, and the full Fitness::hopCost.
+    // Only with the CSR backend (24 bytes per edge); a compressed graph
+    // computes them from the weight columns as it reads them, see hop() and
+    // cost(). Node performance as a dense column.
+    PagedColumn<HopTerms> hopTerms;
+    PagedColumn<double> hopCost;
+    CowVector<double> nodePerf;
+    // Score bounds (Fitness::evaluateBounded): largest nodePerf entry and
+    // the least hop terms of any edge (never above the least, after updates)
+    double perfCeiling = 0.0;
+    HopTerms hopFloor;
+
+    // Per-NodeType bitmaps and lists (NodeTypeIndex.h), rebuilt together
+    // with the adjacency
+    std::shared_ptr<const NodeTypeIndex> types;
+
+    // bumped by GraphStore for every published snapshot
+    unsigned long long version = 0;
+
+    int nodeCount() const { return (int)nodes.size(); }
+    bool hasNode(int v) const { return v >= 0 && v < (int)nodes.size(); }
+
+    bool isCompressed() const { return (bool)packed; }
+    bool isQuantized() const { return (bool)quantized; }
+    bool hasHopColumns() const { return !hopTerms.empty(); }
+
+    // Hop terms and Fitness::hopCost of edge id, precomputed or from the
+    // weight columns; the same bits either way
+    HopTerms hop(size_t id) const {
+        if (!hopTerms.empty()) return hopTerms[id];
+        return HopTerms::of((double)edges.latency[id], (double)edges.bandwidth[id]);
+    }
+    double cost(size_t id) const { return hopCost.empty() ? computeCost(id) : hopCost[id]; }
+
+    NeighborCursor cursor(int v) const {
+        NeighborCursor c;
+        if (packed) {
+            c.p = packed->rowBegin(v);
+            c.pEnd = packed->rowEnd(v);
+            Varint::get(c.p);   // skip degree
+            c.target = v;
+            c.edge = 0;
+            if (c.p == c.pEnd) c.p = c.pEnd = nullptr;   // empty row: plain end state
+        }
+        else {
+            const int* base = adjTargets.data();
+            c.t = base + adjOffsets[v];
+            c.tEnd = base + adjOffsets[v + 1];
+            c.e = adjEdges.data() + adjOffsets[v];
+        }
+        return c;
+    }
+
+    NeighborRange neighbors(int v) const {
+        return { cursor(v), degree(v) };
+    }
+
+    int degree(int v) const {
+        if (packed) return packed->degree(v);
+        return adjOffsets[v + 1] - adjOffsets[v];
+    }
+
+    // Edge id joining a and b (lowest id if parallel), -1 if none.
+    // O(log deg(a)) on CSR, O(deg(a)) on the compressed backend
+    int findEdge(int a, int b) const;
+
+    // The end of edge e across from v, -1 if e doesn't touch v. Walking an
+    // edge-id path with this needs no lookup (see Individual).
+    int across(int e, int v) const {
+        int a = edges.node_a[(size_t)e];
+        int b = edges.node_b[(size_t)e];
+        return a == v ? b : (b == v ? a : -1);
+    }
+
+    // Deep copy that shares no memory with this graph, the node type index
+    // and quantized weights included; the copy's pages are first touched by
+    // the calling thread (see GraphReplicas)
+    Graph clone() const;
+
+    // Changes the weights (and hop costs) of one edge. Only the touched pages
+    // are copied. Drops the quantized weights; call quantizeWeights() again if needed.
+    void setEdgeWeights(int id, double latency, double bandwidth);
+
+    // (Re)build the adjacency from nodes/edges (see GraphBuilder), the node
+    // type index and the hop costs. Edge endpoints must be dense indices.
+    // compressed builds the varint rows directly, else the CSR arrays.
+    void buildAdjacency(int threads = 0, bool compressed = COMPACT_GRAPH);
+
+    // Rebuild only the node type index / only the hop costs (the columns
+    // unless compressed, and the score bounds)
+    void indexNodeTypes();
+    void precomputeCosts();
+
+    // Replace the CSR arrays by their delta/varint encoding and drop the hop
+    // cost columns. Needs the CSR in full first; buildAdjacency(threads,
+    // true) avoids that.
+    void compressAdjacency();
+
+    // Builds the 16-bit weight copy from the current edge columns
+    void quantizeWeights();
+
+    // Bytes held by whichever adjacency backend is active
+    size_t adjacencyBytes() const;
+
+    // Bytes held by the whole graph: nodes, edge columns, adjacency, hop
+    // terms, quantized weights and the node type index
+    size_t bytes() const;
+
+private:
+    double computeCost(size_t id) const;
+};
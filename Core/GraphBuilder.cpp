@@ -0,0 +1,229 @@
+﻿#include "GraphBuilder.h"
+#include "NodeTypeIndex.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr int DIGIT_BITS = 11;
+    constexpr size_t BUCKETS = size_t(1) << DIGIT_BITS;
+
+    int bitsFor(uint64_t maxValue) {
+        int b = 0;
+        while (b < 64 && (maxValue >> b) != 0) ++b;
+        return b;
+    }
+
+    // Stable LSD radix sort of (key, value) pairs on the low keyBits bits.
+    // Per pass: per-thread digit histograms, an exclusive prefix sum over
+    // (digit, thread), then every thread scatters its own chunk in order.
+    void radixSort(std::vector<uint64_t>& keys, std::vector<int>& values, int keyBits, int threads) {
+        const size_t n = keys.size();
+        std::vector<uint64_t> keyTmp(n);
+        std::vector<int> valTmp(n);
+        std::vector<size_t> hist((size_t)threads * BUCKETS);
+
+        for (int shift = 0; shift < keyBits; shift += DIGIT_BITS) {
+            std::fill(hist.begin(), hist.end(), 0);
+
+            Parallel::chunks(n, threads, [&](size_t b, size_t e, int t) {
+                size_t* h = &hist[(size_t)t * BUCKETS];
+                for (size_t i = b; i < e; ++i) ++h[(keys[i] >> shift) & (BUCKETS - 1)];
+            });
+
+            size_t sum = 0;
+            for (size_t d = 0; d < BUCKETS; ++d) {
+                for (int t = 0; t < threads; ++t) {
+                    size_t c = hist[(size_t)t * BUCKETS + d];
+                    hist[(size_t)t * BUCKETS + d] = sum;
+                    sum += c;
+                }
+            }
+
+            Parallel::chunks(n, threads, [&](size_t b, size_t e, int t) {
+                size_t* h = &hist[(size_t)t * BUCKETS];
+                for (size_t i = b; i < e; ++i) {
+                    size_t pos = h[(keys[i] >> shift) & (BUCKETS - 1)]++;
+                    keyTmp[pos] = keys[i];
+                    valTmp[pos] = values[i];
+                }
+            });
+
+            keys.swap(keyTmp);
+            values.swap(valTmp);
+        }
+    }
+}
+
+void GraphBuilder::buildAdjacency(Graph& g, int threads, bool compressed) {
+    const size_t n = g.nodes.size();
+    const size_t m = g.edges.size();
+    if (compressed) {
+        g.packed = std::make_shared<const CompressedAdjacency>(CompressedAdjacency::fromEdges(
+            n, m, g.edges.node_a.data(), g.edges.node_b.data()));
+        g.adjOffsets = AlignedVector<int>();
+        g.adjTargets = AlignedVector<int>();
+        g.adjEdges = AlignedVector<int>();
+        return;
+    }
+
+    const int* ea = g.edges.node_a.data();
+    const int* eb = g.edges.node_b.data();
+    const int nodeBits = bitsFor(n > 0 ? n - 1 : 0);
+    threads = Parallel::threadCount(threads, 2 * m);
+
+    // one directed slot per edge end, key = (source, target); the input is
+    // in edge id order and the sort is stable, so parallel edges keep it
+    std::vector<uint64_t> keys(2 * m);
+    std::vector<int> ids(2 * m);
+    Parallel::chunks(m, threads, [&](size_t b, size_t e, int) {
+        for (size_t id = b; id < e; ++id) {
+            keys[2 * id] = ((uint64_t)ea[id] << nodeBits) | (uint64_t)eb[id];
+            keys[2 * id + 1] = ((uint64_t)eb[id] << nodeBits) | (uint64_t)ea[id];
+            ids[2 * id] = (int)id;
+            ids[2 * id + 1] = (int)id;
+        }
+    });
+    radixSort(keys, ids, 2 * nodeBits, threads);
+
+    const uint64_t targetMask = (uint64_t(1) << nodeBits) - 1;
+    AlignedVector<int> offsets(n + 1, 0);
+    AlignedVector<int> targets(2 * m);
+    AlignedVector<int> edgeIds(2 * m);
+
+    // row starts: slot k opens a row for every source in (source[k-1], source[k]]
+    Parallel::chunks(2 * m, threads, [&](size_t b, size_t e, int) {
+        for (size_t k = b; k < e; ++k) {
+            size_t src = (size_t)(keys[k] >> nodeBits);
+            size_t prev = k == 0 ? 0 : (size_t)(keys[k - 1] >> nodeBits) + 1;
+            for (size_t v = prev; v <= src; ++v) offsets[v] = (int)k;
+            targets[k] = (int)(keys[k] & targetMask);
+            edgeIds[k] = ids[k];
+        }
+    });
+    size_t lastSrc = m == 0 ? 0 : (size_t)(keys[2 * m - 1] >> nodeBits) + 1;
+    for (size_t v = lastSrc; v <= n; ++v) offsets[v] = (int)(2 * m);
+
+    g.packed.reset();
+    g.adjOffsets = std::move(offsets);
+    g.adjTargets = std::move(targets);
+    g.adjEdges = std::move(edgeIds);
+}
+
+Graph GraphBuilder::build(RawGraph raw, const BuildOptions& options, CanonicalizeStats* stats) {
+    const size_t rawNodes = raw.nodes.size();
+    const size_t rawEdges = raw.edgeA.size();
+    if (raw.edgeB.size() != rawEdges || raw.latency.size() != rawEdges || raw.bandwidth.size() != rawEdges)
+        throw std::runtime_error("GraphBuilder: edge arrays differ in length");
+
+    CanonicalizeStats local;
+    CanonicalizeStats& st = stats ? *stats : local;
+    st = {};
+
+    Graph g;
+
+    // ---- dense ids: sort node ids, keep the last definition of each ----
+    int minId = 0;
+    int maxId = 0;
+    for (size_t i = 0; i < rawNodes; ++i) {
+        minId = i ? std::min(minId, raw.nodes[i].id) : raw.nodes[i].id;
+        maxId = i ? std::max(maxId, raw.nodes[i].id) : raw.nodes[i].id;
+    }
+    int threads = Parallel::threadCount(options.threads, rawNodes);
+    std::vector<uint64_t> idKeys(rawNodes);
+    std::vector<int> idPos(rawNodes);
+    for (size_t i = 0; i < rawNodes; ++i) {
+        idKeys[i] = (uint64_t)((int64_t)raw.nodes[i].id - minId);
+        idPos[i] = (int)i;
+    }
+    radixSort(idKeys, idPos, bitsFor((uint64_t)((int64_t)maxId - minId)), threads);
+
+    std::vector<int> ids;   // sorted unique file ids; position = dense index
+    AlignedVector<Node> nodes;
+    ids.reserve(rawNodes);
+    nodes.reserve(rawNodes);
+    for (size_t k = 0; k < rawNodes; ++k) {
+        if (k + 1 < rawNodes && idKeys[k + 1] == idKeys[k]) continue;   // a later duplicate wins
+        ids.push_back(raw.nodes[(size_t)idPos[k]].id);
+        nodes.push_back(raw.nodes[(size_t)idPos[k]]);
+    }
+    g.nodes = std::move(nodes);
+    const size_t n = ids.size();
+
+    auto denseOf = [&](int id) {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        return (it != ids.end() && *it == id) ? (int)(it - ids.begin()) : -1;
+    };
+
+    // ---- endpoints to dense indices; drop dangling edges and self-loops ----
+    threads = Parallel::threadCount(options.threads, rawEdges);
+    std::vector<int> da(rawEdges);
+    std::vector<int> db(rawEdges);
+    Parallel::chunks(rawEdges, threads, [&](size_t b, size_t e, int) {
+        for (size_t i = b; i < e; ++i) {
+            da[i] = denseOf(raw.edgeA[i]);
+            db[i] = denseOf(raw.edgeB[i]);
+        }
+    });
+
+    const int nodeBits = bitsFor(n > 0 ? n - 1 : 0);
+    std::vector<uint64_t> pairKeys;
+    std::vector<int> pairIds;
+    pairKeys.reserve(rawEdges);
+    pairIds.reserve(rawEdges);
+    for (size_t i = 0; i < rawEdges; ++i) {
+        if (da[i] < 0 || db[i] < 0) { ++st.dangling; continue; }
+        if (da[i] == db[i]) { ++st.selfLoops; continue; }
+        uint64_t lo = (uint64_t)std::min(da[i], db[i]);
+        uint64_t hi = (uint64_t)std::max(da[i], db[i]);
+        pairKeys.push_back((lo << nodeBits) | hi);
+        pairIds.push_back((int)i);
+    }
+
+    // ---- canonical edges: group by endpoint pair, one survivor per group ----
+    radixSort(pairKeys, pairIds, 2 * nodeBits, Parallel::threadCount(options.threads, pairKeys.size()));
+
+    // survivors keep the input position of their group's first edge, so
+    // edge ids follow the file order
+    auto rawEdge = [&](size_t r) {
+        return Edge{ da[r], db[r], raw.latency[r], raw.bandwidth[r] };
+    };
+    std::vector<int> groupAt(rawEdges, -1);
+    std::vector<Edge> reps;
+    reps.reserve(pairKeys.size());
+    for (size_t i = 0; i < pairKeys.size();) {
+        size_t j = i + 1;
+        while (j < pairKeys.size() && pairKeys[j] == pairKeys[i]) ++j;
+
+        Edge rep = rawEdge((size_t)pairIds[i]);   // stable sort: first in input order
+        for (size_t k = i + 1; k < j; ++k)
+            GraphCanonicalizer::mergeParallel(options.parallelEdges, rep, rawEdge((size_t)pairIds[k]));
+
+        st.parallel += j - i - 1;
+        groupAt[(size_t)pairIds[i]] = (int)reps.size();
+        reps.push_back(rep);
+        i = j;
+    }
+
+    EdgeList edges;
+    edges.reserve(reps.size());
+    for (size_t r = 0; r < rawEdges; ++r) {
+        if (groupAt[r] >= 0) edges.push_back(reps[(size_t)groupAt[r]]);
+    }
+    g.edges = std::move(edges);
+
+    g.buildAdjacency(options.threads, options.compressAdjacency);
+
+    // start / end: given ids, else the first PC / SERVER, else the smallest /
+    // largest id (dense indices are in ascending id order)
+    int s = denseOf(raw.start_id);
+    int e = denseOf(raw.end_id);
+    if (n > 0) {
+        NodeSpan pcs = g.types->of(NodeType::PC);
+        NodeSpan servers = g.types->of(NodeType::SERVER);
+        g.start_node = s >= 0 ? s : (pcs.empty() ? 0 : pcs[0]);
+        g.end_node = e >= 0 ? e : (servers.empty() ? (int)n - 1 : servers[0]);
+    }
+    return g;
+}
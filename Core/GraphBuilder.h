@@ -0,0 +1,44 @@
+﻿#pragma once
+#include "Graph.h"
+#include "GraphCanonicalizer.h"
+#include <vector>
+
+// Graph as it comes out of a loader or generator: node and endpoint ids are
+// arbitrary ints, edges are plain parallel arrays.
+struct RawGraph {
+    std::vector<Node> nodes;        // duplicate ids: the last one wins
+    std::vector<int> edgeA;
+    std::vector<int> edgeB;
+    std::vector<double> latency;
+    std::vector<double> bandwidth;
+
+    int start_id = 0;               // unknown ids fall back to a PC / SERVER
+    int end_id = 0;
+
+    void addEdge(int a, int b, double lat, double bw) {
+        edgeA.push_back(a);
+        edgeB.push_back(b);
+        latency.push_back(lat);
+        bandwidth.push_back(bw);
+    }
+};
+
+struct BuildOptions {
+    ParallelEdgePolicy parallelEdges = ParallelEdgePolicy::KeepBest;
+    int threads = 0;                // 0: all hardware threads
+    bool compressAdjacency = COMPACT_GRAPH; // varint rows, the CSR is never built
+};
+
+// Bulk construction of the indexed Graph. Dense ids, canonical edges and the
+// CSR/edge index are all produced by parallel LSD radix sorts (by id, by
+// endpoint pair, by source) plus prefix sums, so building is O(E) per pass
+// and scales across cores. Small inputs run on one thread.
+class GraphBuilder {
+public:
+    static Graph build(RawGraph raw, const BuildOptions& options = {}, CanonicalizeStats* stats = nullptr);
+
+    // CSR arrays and edge index of g from its edge columns (rows sorted by
+    // target, parallel edges in id order), or the same rows encoded as
+    // CompressedAdjacency. Graph::buildAdjacency uses this.
+    static void buildAdjacency(Graph& g, int threads = 0, bool compressed = false);
+};
@@ -0,0 +1,13 @@
+﻿#include "GraphCanonicalizer.h"
+#include "Fitness.h"
+#include <algorithm>
+
+void GraphCanonicalizer::mergeParallel(ParallelEdgePolicy policy, Edge& kept, const Edge& other) {
+    if (policy == ParallelEdgePolicy::KeepBest) {
+        if (Fitness::hopCost(other.latency, other.bandwidth) < Fitness::hopCost(kept.latency, kept.bandwidth)) kept = other;
+    }
+    else if (policy == ParallelEdgePolicy::Aggregate) {
+        kept.latency = std::min(kept.latency, other.latency);
+        kept.bandwidth += other.bandwidth;
+    }
+}
@@ -0,0 +1,24 @@
+﻿#pragma once
+#include "Graph.h"
+#include <cstddef>
+
+// How edges joining the same node pair are collapsed into one
+enum class ParallelEdgePolicy {
+    KeepFirst,   // first edge in input order (what the solver used to see)
+    KeepBest,    // edge with the lowest Fitness::hopCost
+    Aggregate    // links in parallel: min latency, summed bandwidth
+};
+
+struct CanonicalizeStats {
+    size_t dangling = 0;    // endpoint is not a node
+    size_t selfLoops = 0;
+    size_t parallel = 0;    // edges merged into another one
+};
+
+// Canonicalization itself is part of GraphBuilder::build, the one path
+// every loaded or generated graph goes through
+class GraphCanonicalizer {
+public:
+    // Folds `other` into `kept`, the group's representative so far
+    static void mergeParallel(ParallelEdgePolicy policy, Edge& kept, const Edge& other);
+};
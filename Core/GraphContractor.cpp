@@ -0,0 +1,121 @@
+﻿#include "GraphContractor.h"
+#include "NodeTypeIndex.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <unordered_set>
+
+std::vector<int> ContractedGraph::expand(const std::vector<int>& path) const {
+    std::vector<int> out;
+    out.reserve(path.size());
+
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (i > 0) {
+            int e = graph.findEdge(path[i - 1], path[i]);
+            if (e >= firstSuperEdge) {
+                size_t k = (size_t)(e - firstSuperEdge);
+                auto from = chainNodes.begin() + chainOffsets[k];
+                auto to = chainNodes.begin() + chainOffsets[k + 1];
+                if (graph.edges.node_a[(size_t)e] == path[i - 1]) out.insert(out.end(), from, to);
+                else out.insert(out.end(), std::make_reverse_iterator(to), std::make_reverse_iterator(from));
+            }
+        }
+        out.push_back(origin[(size_t)path[i]]);
+    }
+    return out;
+}
+
+void ContractedGraph::remapSource(const std::vector<int>& sourceOrigin) {
+    for (int& v : origin) v = sourceOrigin[(size_t)v];
+    for (int& v : chainNodes) v = sourceOrigin[(size_t)v];
+}
+
+ContractedGraph GraphContractor::contract(const Graph& g, unsigned keepTypes) {
+    const int n = g.nodeCount();
+    auto interior = [&](int v) {
+        return g.degree(v) == 2 && v != g.start_node && v != g.end_node
+            && !(typeBit(g.nodes[(size_t)v].type) & keepTypes);
+    };
+
+    // super-edges in source indices; their interiors go to nodes/offsets
+    std::vector<Edge> superEdges;
+    std::vector<int> offsets(1, 0);
+    std::vector<int> nodes;
+    std::vector<char> removed((size_t)n, 0);
+    std::vector<char> walked((size_t)n, 0);
+    std::unordered_set<unsigned long long> joined;   // end pairs of taken chains
+    std::vector<int> chain;
+
+    for (int u = 0; u < n; ++u) {
+        if (interior(u)) continue;
+
+        for (NeighborCursor c = g.cursor(u); c.next();) {
+            if (!interior(c.target) || walked[(size_t)c.target]) continue;
+
+            // walk until the first anchor (non-interior node)
+            chain.clear();
+            double latency = 0.0;
+            double bandwidth = std::numeric_limits<double>::infinity();
+            int edge = c.edge;
+            int v = c.target;
+            while (true) {
+                latency += g.edges.latency[(size_t)edge];
+                bandwidth = std::min(bandwidth, (double)g.edges.bandwidth[(size_t)edge]);
+                if (!interior(v)) break;
+
+                walked[(size_t)v] = 1;
+                chain.push_back(v);
+                for (NeighborCursor d = g.cursor(v); d.next();) {
+                    if (d.edge == edge) continue;
+                    edge = d.edge;
+                    v = d.target;
+                    break;
+                }
+            }
+            int w = v;
+            unsigned long long key = ((unsigned long long)std::min(u, w) << 32) | (unsigned)std::max(u, w);
+            if (w == u || g.findEdge(u, w) >= 0 || !joined.insert(key).second) continue;
+
+            for (int x : chain) removed[(size_t)x] = 1;
+            nodes.insert(nodes.end(), chain.begin(), chain.end());
+            offsets.push_back((int)nodes.size());
+            superEdges.push_back({ u, w, latency, bandwidth });
+        }
+    }
+
+    ContractedGraph out;
+    std::vector<int> newIndex((size_t)n, -1);
+    for (int v = 0; v < n; ++v) {
+        if (removed[(size_t)v]) continue;
+        newIndex[(size_t)v] = (int)out.graph.nodes.size();
+        out.graph.nodes.push_back(g.nodes[(size_t)v]);
+        out.origin.push_back(v);
+    }
+
+    // surviving edges first, in order, then one super-edge per chain
+    for (size_t id = 0; id < g.edges.size(); ++id) {
+        Edge e = g.edges[id];
+        if (removed[(size_t)e.node_a] || removed[(size_t)e.node_b]) continue;
+        e.node_a = newIndex[(size_t)e.node_a];
+        e.node_b = newIndex[(size_t)e.node_b];
+        out.graph.edges.push_back(e);
+    }
+    out.firstSuperEdge = (int)out.graph.edges.size();
+    for (Edge e : superEdges) {
+        e.node_a = newIndex[(size_t)e.node_a];
+        e.node_b = newIndex[(size_t)e.node_b];
+        out.graph.edges.push_back(e);
+    }
+    out.chainOffsets = std::move(offsets);
+    out.chainNodes = std::move(nodes);
+
+    out.graph.start_node = g.hasNode(g.start_node) ? newIndex[(size_t)g.start_node] : 0;
+    out.graph.end_node = g.hasNode(g.end_node) ? newIndex[(size_t)g.end_node] : 0;
+    out.graph.buildAdjacency(0, g.isCompressed());
+    if (g.isQuantized()) out.graph.quantizeWeights();
+
+    std::cout << "[GraphContractor] Nodes=" << g.nodeCount() << "->" << out.graph.nodeCount()
+        << " Edges=" << g.edges.size() << "->" << out.graph.edges.size()
+        << " Chains=" << out.chains() << "\n";
+    return out;
+}
@@ -0,0 +1,44 @@
+﻿#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <vector>
+
+// Working graph with maximal degree-2 chains folded into super-edges
+struct ContractedGraph {
+    Graph graph;
+    std::vector<int> origin;        // origin[v] = index of v in the source graph
+
+    // Super-edges are the edge ids from firstSuperEdge on. The interior nodes
+    // of super-edge e (source indices, ordered from node_a to node_b) are
+    // chainNodes[chainOffsets[k] .. chainOffsets[k + 1]), k = e - firstSuperEdge.
+    int firstSuperEdge = 0;
+    std::vector<int> chainOffsets;
+    std::vector<int> chainNodes;
+
+    size_t chains() const { return chainOffsets.empty() ? 0 : chainOffsets.size() - 1; }
+
+    // Maps a path over graph back to the full hop list in source indices
+    std::vector<int> expand(const std::vector<int>& path) const;
+
+    // Composes with an earlier mapping (e.g. PrunedGraph::origin), so that
+    // expand() yields indices of the graph that one came from
+    void remapSource(const std::vector<int>& sourceOrigin);
+};
+
+// Chains of non-terminal degree-2 nodes offer no routing choice; each one
+// becomes a single edge with the summed latency and the bottleneck bandwidth.
+// Chains whose ends are already adjacent (or joined by an earlier chain), and
+// rings, are left as they are so the result stays a simple graph. Nodes of
+// the types in keepTypes (typeBit() masks) are never folded, so a route
+// policy on those types still sees them.
+//
+// Fitness on the contracted graph is only approximate: a super-edge counts
+// as one hop, its bandwidth term is its latency over the bottleneck rather
+// than the per-hop sum, and the interior nodes' performance is left out. A
+// search there can prefer a long chain over a route that is really cheaper,
+// and re-scoring after expand() doesn't undo that choice, so the drivers
+// only contract on request (--contract).
+class GraphContractor {
+public:
+    static ContractedGraph contract(const Graph& g, unsigned keepTypes = 0);
+};
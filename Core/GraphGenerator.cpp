@@ -1,8 +1,10 @@
 ﻿#include "GraphGenerator.h"
+#include "GraphBuilder.h"
 #include <random>
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <utility>
 
 static std::mt19937 rng(std::random_device{}());
 
@@ -27,7 +29,11 @@ static NodeType pickType(int layer, int layers) {
 }
 
 Graph GraphGenerator::generate(int n) {
-    Graph g;
+    RawGraph raw;
+    raw.nodes.reserve((size_t)std::max(0, n));
+
+    int start = -1;
+    int end = -1;
 
     const int LAYERS = 6;
     const double INTRA_P = 0.2;
@@ -42,13 +48,13 @@ Graph GraphGenerator::generate(int n) {
         node.type = pickType(layer, LAYERS);
         node.performance = randInt(100, 1000);
 
-        g.nodes[i] = node;
+        raw.nodes.push_back(node); // ids 0..n-1, so dense index == id
 
-        if (node.type == NodeType::PC && g.start_node == -1)
-            g.start_node = i;
+        if (node.type == NodeType::PC && start == -1)
+            start = i;
 
         if (node.type == NodeType::SERVER)
-            g.end_node = i; // last SERVER becomes end
+            end = i; // last SERVER becomes end
     }
 
     // ---- edges ----
@@ -63,26 +69,29 @@ Graph GraphGenerator::generate(int n) {
 
             double p = same ? INTRA_P : (adjacent ? INTER_P : 0.0);
             if (rand01() < p) {
-                Edge e;
-                e.node_a = i;
-                e.node_b = j;
-                e.latency = rand01() * 10.0 + 1.0;
-                e.bandwidth = rand01() * 9.0 + 1.0;
-                g.edges.push_back(e);
+                double latency = rand01() * 10.0 + 1.0;
+                double bandwidth = rand01() * 9.0 + 1.0;
+                raw.addEdge(i, j, latency, bandwidth);
             }
         }
     }
 
     // ---- FORCE guaranteed path start -> end ----
-    if (g.start_node != -1 && g.end_node != -1 && g.start_node != g.end_node) {
-        int current = g.start_node;
-        while (current != g.end_node) {
-            int next = std::min(current + 1, g.end_node);
-            g.edges.push_back({ current, next, 1.0, 10.0 });
+    if (start != -1 && end != -1 && start != end) {
+        int current = start;
+        while (current != end) {
+            int next = std::min(current + 1, end);
+            raw.addEdge(current, next, 1.0, 10.0);
             current = next;
         }
     }
 
+    raw.start_id = std::max(0, start);
+    raw.end_id = std::max(0, end);
+
+    // the forced chain overlaps random edges; the builder collapses them
+    Graph g = GraphBuilder::build(std::move(raw));
+
     std::cout << "[GraphGenerator] Nodes=" << g.nodes.size()
         << " Edges=" << g.edges.size()
         << " Start=" << g.start_node
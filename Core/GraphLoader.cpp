@@ -1,4 +1,5 @@
 ﻿#include "GraphLoader.h"
+#include "GraphBuilder.h"
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -132,7 +133,7 @@ static bool isKnownKey(const std::string& key) {
 // -----------------------------
 // Parsing specific structures
 // -----------------------------
-static void parseNodesArray(const std::string& s, size_t& i, Graph& g) {
+static void parseNodesArray(const std::string& s, size_t& i, std::vector<Node>& nodes) {
     expect(s, i, '[', "JSON: nodes should be array");
     skipWs(s, i);
     if (consume(s, i, ']')) return;
@@ -158,7 +159,7 @@ static void parseNodesArray(const std::string& s, size_t& i, Graph& g) {
             }
         }
 
-        g.nodes[n.id] = n;
+        nodes.push_back(n);   // duplicate ids are resolved by GraphBuilder
 
         skipWs(s, i);
         if (consume(s, i, ']')) break;
@@ -166,7 +167,7 @@ static void parseNodesArray(const std::string& s, size_t& i, Graph& g) {
     }
 }
 
-static void parseEdgesArray(const std::string& s, size_t& i, Graph& g) {
+static void parseEdgesArray(const std::string& s, size_t& i, RawGraph& raw) {
     expect(s, i, '[', "JSON: edges should be array");
     skipWs(s, i);
     if (consume(s, i, ']')) return;
@@ -193,7 +194,7 @@ static void parseEdgesArray(const std::string& s, size_t& i, Graph& g) {
             }
         }
 
-        g.edges.push_back(e);
+        raw.addEdge(e.node_a, e.node_b, e.latency, e.bandwidth);
 
         skipWs(s, i);
         if (consume(s, i, ']')) break;
@@ -201,7 +202,7 @@ static void parseEdgesArray(const std::string& s, size_t& i, Graph& g) {
     }
 }
 
-Graph GraphLoader::loadFromFile(const std::string& path) {
+Graph GraphLoader::loadFromFile(const std::string& path, const LoadOptions& options) {
     std::ifstream in(path, std::ios::binary);
     if (!in) throw std::runtime_error("GraphLoader: cannot open file: " + path);
 
@@ -209,7 +210,7 @@ Graph GraphLoader::loadFromFile(const std::string& path) {
     ss << in.rdbuf();
     std::string s = ss.str();
 
-    Graph g;
+    RawGraph raw;   // ids as written in the file
 
     size_t i = 0;
     expect(s, i, '{', "JSON: root must be object");
@@ -221,44 +222,47 @@ Graph GraphLoader::loadFromFile(const std::string& path) {
         std::string key = parseString(s, i);
         expect(s, i, ':', "JSON: expected : in root");
 
-        if (key == "nodes") parseNodesArray(s, i, g);
-        else if (key == "edges") parseEdgesArray(s, i, g);
-        else if (key == "start_node") g.start_node = (int)parseNumber(s, i);
-        else if (key == "end_node") g.end_node = (int)parseNumber(s, i);
+        if (key == "nodes") parseNodesArray(s, i, raw.nodes);
+        else if (key == "edges") parseEdgesArray(s, i, raw);
+        else if (key == "start_node") raw.start_id = (int)parseNumber(s, i);
+        else if (key == "end_node") raw.end_id = (int)parseNumber(s, i);
         else skipValue(s, i);
 
         skipWs(s, i);
         if (consume(s, i, '}')) break;
         expect(s, i, ',', "JSON: expected , in root");
     }
+    s = {};
 
-    if (g.nodes.empty()) throw std::runtime_error("GraphLoader: nodes is empty");
+    if (raw.nodes.empty()) throw std::runtime_error("GraphLoader: nodes is empty");
+
+    // Dense ids, canonical edges and adjacency in one bulk pass. If the generator
+    // didn't write start/end, the builder picks a PC / SERVER
+    BuildOptions build;
+    build.parallelEdges = options.parallelEdges;
+    build.compressAdjacency = options.compressAdjacency;
+    CanonicalizeStats canon;
+    Graph g = GraphBuilder::build(std::move(raw), build, &canon);
     if (g.edges.empty()) throw std::runtime_error("GraphLoader: edges is empty");
 
-    // If generator didn't write start/end, choose sane defaults
-    if (!g.nodes.count(g.start_node)) {
-        // prefer a PC if exists, else smallest id
-        int best = g.nodes.begin()->first;
-        for (auto& kv : g.nodes) best = std::min(best, kv.first);
-        for (auto& kv : g.nodes) {
-            if (kv.second.type == NodeType::PC) { best = kv.first; break; }
-        }
-        g.start_node = best;
-    }
-    if (!g.nodes.count(g.end_node)) {
-        // prefer a SERVER if exists, else largest id
-        int best = g.nodes.begin()->first;
-        for (auto& kv : g.nodes) best = std::max(best, kv.first);
-        for (auto& kv : g.nodes) {
-            if (kv.second.type == NodeType::SERVER) { best = kv.first; break; }
-        }
-        g.end_node = best;
-    }
+    GraphReorder::apply(g, options.order);
+    if (options.quantizeWeights) g.quantizeWeights();
 
     std::cout << "[GraphLoader] Loaded graph. Nodes=" << g.nodes.size()
         << " Edges=" << g.edges.size()
-        << " Start=" << g.start_node
-        << " End=" << g.end_node << "\n";
+        << " Dangling=" << canon.dangling
+        << " SelfLoops=" << canon.selfLoops
+        << " Parallel=" << canon.parallel
+        << " AdjBytes=" << g.adjacencyBytes()
+        << " GraphBytes=" << g.bytes()
+        << " Start=" << g.nodes[g.start_node].id
+        << " End=" << g.nodes[g.end_node].id << "\n";
+    if (g.quantized) {
+        std::cout << "[GraphLoader] Quantized weights. Bytes=" << g.quantized->bytes()
+            << " MaxRelErr lat=" << g.quantized->latency.maxRelError
+            << " bw=" << g.quantized->bandwidth.maxRelError
+            << " penalty=" << g.quantized->penalty.maxRelError << "\n";
+    }
 
     return g;
 }
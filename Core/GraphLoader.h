@@ -0,0 +1,17 @@
+﻿#pragma once
+#include "Graph.h"
+#include "GraphCanonicalizer.h"
+#include "GraphReorder.h"
+#include <string>
+
+struct LoadOptions {
+    ParallelEdgePolicy parallelEdges = ParallelEdgePolicy::KeepBest;
+    NodeOrder order = NodeOrder::None;   // relabeling applied after canonicalization
+    bool compressAdjacency = COMPACT_GRAPH; // varint adjacency instead of CSR (large graphs)
+    bool quantizeWeights = false;        // 16-bit weights for the fitness kernel
+};
+
+class GraphLoader {
+public:
+    static Graph loadFromFile(const std::string& path, const LoadOptions& options = {});
+};
@@ -0,0 +1,484 @@
+﻿#include "GraphPartitioner.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+    constexpr int COARSEST = 200;          // stop coarsening below this many vertices
+    constexpr int MATCH_ROUNDS = 4;
+    constexpr int INITIAL_TRIES = 8;
+    constexpr int FM_PASSES = 6;
+    constexpr int FM_STALL = 200;          // non-improving moves before a pass gives up
+    constexpr int SPLIT_IN_THREAD = 50000; // bisect both halves concurrently above this
+
+    // Vertex- and edge-weighted graph the levels are made of
+    struct WGraph {
+        std::vector<int> xadj{ 0 };
+        std::vector<int> adj;
+        std::vector<int> ew;
+        std::vector<int> vw;
+
+        int n() const { return (int)vw.size(); }
+        long long totalWeight() const {
+            long long w = 0;
+            for (int x : vw) w += x;
+            return w;
+        }
+    };
+
+    WGraph fromGraph(const Graph& g) {
+        WGraph w;
+        const int n = g.nodeCount();
+        w.vw.assign((size_t)n, 1);
+        w.xadj.resize((size_t)n + 1);
+        w.adj.reserve(g.edges.size() * 2);
+        for (int v = 0; v < n; ++v) {
+            for (int u : g.neighbors(v)) {
+                if (u == v) continue;
+                w.adj.push_back(u);
+                w.ew.push_back(1);
+            }
+            w.xadj[(size_t)v + 1] = (int)w.adj.size();
+        }
+        return w;
+    }
+
+    uint32_t mix(uint32_t x) {
+        x ^= x >> 16; x *= 0x7feb352d;
+        x ^= x >> 15; x *= 0x846ca68b;
+        return x ^ (x >> 16);
+    }
+
+    // ---- coarsening ----
+
+    // Heavy-edge matching by handshakes: every free vertex points at its
+    // heaviest free neighbor and mutual pairs match. Each round reads the
+    // previous state only, so vertices are processed in parallel without
+    // locks. A serial sweep then pairs what is left.
+    std::vector<int> heavyEdgeMatching(const WGraph& w, int maxVertexWeight, int threads, uint32_t salt) {
+        const int n = w.n();
+        std::vector<int> match((size_t)n, -1);
+        std::vector<int> want((size_t)n, -1);
+
+        auto heaviestFree = [&](int v) {
+            int best = -1;
+            int bestW = -1;
+            uint32_t bestTie = 0;
+            for (int k = w.xadj[(size_t)v]; k < w.xadj[(size_t)v + 1]; ++k) {
+                int u = w.adj[(size_t)k];
+                if (match[(size_t)u] != -1 || w.vw[(size_t)u] + w.vw[(size_t)v] > maxVertexWeight) continue;
+                uint32_t tie = mix((uint32_t)(std::min(u, v) * 2654435761u) ^ (uint32_t)std::max(u, v) ^ salt);
+                if (w.ew[(size_t)k] > bestW || (w.ew[(size_t)k] == bestW && tie > bestTie)) {
+                    best = u;
+                    bestW = w.ew[(size_t)k];
+                    bestTie = tie;
+                }
+            }
+            return best;
+        };
+
+        for (int round = 0; round < MATCH_ROUNDS; ++round) {
+            Parallel::chunks((size_t)n, threads, [&](size_t b, size_t e, int) {
+                for (size_t v = b; v < e; ++v) want[v] = match[v] == -1 ? heaviestFree((int)v) : -1;
+            });
+            Parallel::chunks((size_t)n, threads, [&](size_t b, size_t e, int) {
+                for (size_t v = b; v < e; ++v) {
+                    int u = want[v];
+                    if (u >= 0 && want[(size_t)u] == (int)v) match[v] = u;
+                }
+            });
+        }
+
+        for (int v = 0; v < n; ++v) {
+            if (match[(size_t)v] != -1) continue;
+            int u = heaviestFree(v);
+            match[(size_t)v] = u >= 0 ? u : v;
+            if (u >= 0) match[(size_t)u] = v;
+        }
+        return match;
+    }
+
+    // Collapses matched pairs; cmap[v] = coarse vertex of v
+    WGraph contract(const WGraph& w, const std::vector<int>& match, std::vector<int>& cmap, int threads) {
+        const int n = w.n();
+        cmap.assign((size_t)n, -1);
+        std::vector<int> leader;   // fine vertex each coarse vertex is named after
+        for (int v = 0; v < n; ++v) {
+            if (v > match[(size_t)v]) continue;
+            cmap[(size_t)v] = (int)leader.size();
+            leader.push_back(v);
+        }
+        for (int v = 0; v < n; ++v) {
+            if (cmap[(size_t)v] < 0) cmap[(size_t)v] = cmap[(size_t)match[(size_t)v]];
+        }
+
+        const int nc = (int)leader.size();
+        WGraph c;
+        c.vw.resize((size_t)nc);
+        std::vector<int> bound((size_t)nc + 1, 0);   // degree upper bound -> offsets
+        for (int x = 0; x < nc; ++x) {
+            int v = leader[(size_t)x];
+            int u = match[(size_t)v];
+            c.vw[(size_t)x] = w.vw[(size_t)v] + (u != v ? w.vw[(size_t)u] : 0);
+            int deg = w.xadj[(size_t)v + 1] - w.xadj[(size_t)v];
+            if (u != v) deg += w.xadj[(size_t)u + 1] - w.xadj[(size_t)u];
+            bound[(size_t)x + 1] = bound[(size_t)x] + deg;
+        }
+
+        // every coarse row is gathered, sorted and merged in its own slot range
+        std::vector<std::pair<int, int>> slots((size_t)bound[(size_t)nc]);
+        std::vector<int> rowSize((size_t)nc, 0);
+        Parallel::chunks((size_t)nc, threads, [&](size_t b, size_t e, int) {
+            for (size_t x = b; x < e; ++x) {
+                auto* row = slots.data() + bound[x];
+                int len = 0;
+                int v = leader[x];
+                int u = match[(size_t)v];
+                for (int f : { v, u }) {
+                    for (int k = w.xadj[(size_t)f]; k < w.xadj[(size_t)f + 1]; ++k) {
+                        int t = cmap[(size_t)w.adj[(size_t)k]];
+                        if (t != (int)x) row[len++] = { t, w.ew[(size_t)k] };
+                    }
+                    if (u == v) break;
+                }
+                std::sort(row, row + len);
+                int out = 0;
+                for (int k = 0; k < len; ++k) {
+                    if (out > 0 && row[out - 1].first == row[k].first) row[out - 1].second += row[k].second;
+                    else row[out++] = row[k];
+                }
+                rowSize[x] = out;
+            }
+        });
+
+        c.xadj.assign((size_t)nc + 1, 0);
+        for (int x = 0; x < nc; ++x) c.xadj[(size_t)x + 1] = c.xadj[(size_t)x] + rowSize[(size_t)x];
+        c.adj.resize((size_t)c.xadj[(size_t)nc]);
+        c.ew.resize(c.adj.size());
+        Parallel::chunks((size_t)nc, threads, [&](size_t b, size_t e, int) {
+            for (size_t x = b; x < e; ++x) {
+                for (int k = 0; k < rowSize[x]; ++k) {
+                    c.adj[(size_t)c.xadj[x] + (size_t)k] = slots[(size_t)bound[x] + (size_t)k].first;
+                    c.ew[(size_t)c.xadj[x] + (size_t)k] = slots[(size_t)bound[x] + (size_t)k].second;
+                }
+            }
+        });
+        return c;
+    }
+
+    // ---- bisection ----
+
+    struct Bisection {
+        std::vector<char> side;
+        long long weight[2] = { 0, 0 };
+        long long maxWeight[2] = { 0, 0 };
+        long long cut = 0;
+
+        long long overweight() const {
+            return std::max(0LL, weight[0] - maxWeight[0]) + std::max(0LL, weight[1] - maxWeight[1]);
+        }
+        bool betterThan(long long over, long long c) const {
+            return overweight() < over || (overweight() == over && cut < c);
+        }
+    };
+
+    long long cutOf(const WGraph& w, const std::vector<char>& side) {
+        long long c = 0;
+        for (int v = 0; v < w.n(); ++v) {
+            for (int k = w.xadj[(size_t)v]; k < w.xadj[(size_t)v + 1]; ++k) {
+                if (side[(size_t)v] != side[(size_t)w.adj[(size_t)k]]) c += w.ew[(size_t)k];
+            }
+        }
+        return c / 2;
+    }
+
+    // Fiduccia-Mattheyses passes: move the best-gain vertex that keeps (or
+    // restores) balance, lock it, and roll back to the best state of the pass
+    void refineFM(const WGraph& w, Bisection& b) {
+        const int n = w.n();
+        std::vector<int> gain((size_t)n);
+        std::vector<char> locked((size_t)n);
+        std::vector<int> moves;
+
+        for (int pass = 0; pass < FM_PASSES; ++pass) {
+            std::priority_queue<std::pair<int, int>> heap;   // (gain, vertex), lazily updated
+            for (int v = 0; v < n; ++v) {
+                int ext = 0;
+                int in = 0;
+                for (int k = w.xadj[(size_t)v]; k < w.xadj[(size_t)v + 1]; ++k) {
+                    if (b.side[(size_t)w.adj[(size_t)k]] != b.side[(size_t)v]) ext += w.ew[(size_t)k];
+                    else in += w.ew[(size_t)k];
+                }
+                gain[(size_t)v] = ext - in;
+                if (ext > 0 || b.overweight() > 0) heap.push({ gain[(size_t)v], v });
+            }
+            std::fill(locked.begin(), locked.end(), 0);
+            moves.clear();
+
+            long long bestOver = b.overweight();
+            long long bestCut = b.cut;
+            size_t bestLen = 0;
+            int stall = 0;
+
+            while (!heap.empty() && stall < FM_STALL) {
+                auto [g, v] = heap.top();
+                heap.pop();
+                if (locked[(size_t)v] || g != gain[(size_t)v]) continue;
+
+                int from = b.side[(size_t)v];
+                int to = 1 - from;
+                bool fits = b.weight[to] + w.vw[(size_t)v] <= b.maxWeight[to];
+                bool rebalances = b.weight[from] > b.maxWeight[from];
+                if (!fits && !rebalances) continue;
+
+                locked[(size_t)v] = 1;
+                b.side[(size_t)v] = (char)to;
+                b.weight[from] -= w.vw[(size_t)v];
+                b.weight[to] += w.vw[(size_t)v];
+                b.cut -= g;
+                moves.push_back(v);
+
+                for (int k = w.xadj[(size_t)v]; k < w.xadj[(size_t)v + 1]; ++k) {
+                    int u = w.adj[(size_t)k];
+                    if (locked[(size_t)u]) continue;
+                    gain[(size_t)u] += b.side[(size_t)u] == to ? -2 * w.ew[(size_t)k] : 2 * w.ew[(size_t)k];
+                    heap.push({ gain[(size_t)u], u });
+                }
+
+                if (b.betterThan(bestOver, bestCut)) {
+                    bestOver = b.overweight();
+                    bestCut = b.cut;
+                    bestLen = moves.size();
+                    stall = 0;
+                }
+                else {
+                    ++stall;
+                }
+            }
+
+            // undo the moves after the best state
+            for (size_t i = moves.size(); i > bestLen; --i) {
+                int v = moves[i - 1];
+                int to = b.side[(size_t)v];
+                b.side[(size_t)v] = (char)(1 - to);
+                b.weight[to] -= w.vw[(size_t)v];
+                b.weight[1 - to] += w.vw[(size_t)v];
+            }
+            b.cut = bestCut;
+            if (bestLen == 0) break;
+        }
+    }
+
+    // Greedy graph growing: side 0 grows from a random seed, always taking
+    // the frontier vertex that adds the least cut, until it reaches its target
+    Bisection growBisection(const WGraph& w, long long target0, long long max0, long long max1, std::mt19937& rng) {
+        const int n = w.n();
+        Bisection best;
+        long long bestOver = 0;
+        long long bestCut = 0;
+
+        for (int attempt = 0; attempt < INITIAL_TRIES; ++attempt) {
+            Bisection b;
+            b.side.assign((size_t)n, 1);
+            b.weight[1] = w.totalWeight();
+            b.maxWeight[0] = max0;
+            b.maxWeight[1] = max1;
+
+            std::vector<int> gain((size_t)n, 0);
+            std::priority_queue<std::pair<int, int>> frontier;
+            std::vector<int> seeds((size_t)n);
+            for (int v = 0; v < n; ++v) seeds[(size_t)v] = v;
+            std::shuffle(seeds.begin(), seeds.end(), rng);
+            size_t nextSeed = 0;
+            auto take = [&](int v) {
+                b.side[(size_t)v] = 0;
+                b.weight[0] += w.vw[(size_t)v];
+                b.weight[1] -= w.vw[(size_t)v];
+                for (int k = w.xadj[(size_t)v]; k < w.xadj[(size_t)v + 1]; ++k) {
+                    int u = w.adj[(size_t)k];
+                    if (b.side[(size_t)u] == 0) continue;
+                    gain[(size_t)u] += 2 * w.ew[(size_t)k];
+                    frontier.push({ gain[(size_t)u], u });
+                }
+            };
+
+            while (b.weight[0] < target0) {
+                int v = -1;
+                while (!frontier.empty()) {
+                    auto [g, u] = frontier.top();
+                    frontier.pop();
+                    if (b.side[(size_t)u] == 1 && g == gain[(size_t)u]) { v = u; break; }
+                }
+                if (v < 0) {
+                    // new seed: first step or disconnected input
+                    while (nextSeed < seeds.size() && b.side[(size_t)seeds[nextSeed]] == 0) ++nextSeed;
+                    if (nextSeed == seeds.size()) break;
+                    v = seeds[nextSeed];
+                }
+                take(v);
+            }
+
+            b.cut = cutOf(w, b.side);
+            refineFM(w, b);
+            if (attempt == 0 || b.betterThan(bestOver, bestCut)) {
+                bestOver = b.overweight();
+                bestCut = b.cut;
+                best = std::move(b);
+            }
+        }
+        return best;
+    }
+
+    // Multilevel bisection; side 0 gets about `fraction` of the weight
+    std::vector<char> bisect(const WGraph& w, double fraction, double imbalance, int threads, std::mt19937& rng) {
+        const long long total = w.totalWeight();
+        const long long target0 = (long long)(fraction * (double)total + 0.5);
+        const long long max0 = (long long)((1.0 + imbalance) * (double)target0) + 1;
+        const long long max1 = (long long)((1.0 + imbalance) * (double)(total - target0)) + 1;
+
+        std::vector<WGraph> levels;
+        std::vector<std::vector<int>> maps;
+        const WGraph* cur = &w;
+        int maxVertexWeight = (int)std::max(2LL, (long long)(1.5 * (double)total / COARSEST));
+
+        while (cur->n() > COARSEST) {
+            std::vector<int> match = heavyEdgeMatching(*cur, maxVertexWeight,
+                Parallel::threadCount(threads, (size_t)cur->n()), (uint32_t)rng());
+            std::vector<int> cmap;
+            WGraph next = contract(*cur, match, cmap, Parallel::threadCount(threads, (size_t)cur->n()));
+            if (next.n() > cur->n() * 95 / 100) break;   // matching stalled
+            maps.push_back(std::move(cmap));
+            levels.push_back(std::move(next));
+            cur = &levels.back();
+        }
+
+        Bisection b = growBisection(*cur, target0, max0, max1, rng);
+
+        // project back level by level, refining each
+        for (size_t i = levels.size(); i > 0; --i) {
+            const WGraph& fine = i >= 2 ? levels[i - 2] : w;
+            const std::vector<int>& cmap = maps[i - 1];
+            std::vector<char> side((size_t)fine.n());
+            for (int v = 0; v < fine.n(); ++v) side[(size_t)v] = b.side[(size_t)cmap[(size_t)v]];
+            b.side = std::move(side);
+            refineFM(fine, b);
+        }
+        return b.side;
+    }
+
+    // Induced subgraph of one side; local[v] = index inside it
+    WGraph inducedSide(const WGraph& w, const std::vector<char>& side, char which, std::vector<int>& local, std::vector<int>& members) {
+        members.clear();
+        for (int v = 0; v < w.n(); ++v) {
+            if (side[(size_t)v] != which) continue;
+            local[(size_t)v] = (int)members.size();
+            members.push_back(v);
+        }
+
+        WGraph s;
+        s.vw.reserve(members.size());
+        s.xadj.reserve(members.size() + 1);
+        for (int v : members) {
+            s.vw.push_back(w.vw[(size_t)v]);
+            for (int k = w.xadj[(size_t)v]; k < w.xadj[(size_t)v + 1]; ++k) {
+                int u = w.adj[(size_t)k];
+                if (side[(size_t)u] != which) continue;
+                s.adj.push_back(local[(size_t)u]);
+                s.ew.push_back(w.ew[(size_t)k]);
+            }
+            s.xadj.push_back((int)s.adj.size());
+        }
+        return s;
+    }
+
+    // Splits w into parts [firstPart, firstPart + k) by recursive bisection.
+    // A part goes through up to ceil(log2 parts) bisections and each may
+    // overshoot by `imbalance`, so that is the per-level share of the total.
+    void recurse(const WGraph& w, const std::vector<int>& ids, int firstPart, int k, double imbalance,
+                 const PartitionOptions& options, unsigned seed, std::vector<int>& part) {
+        if (k == 1 || w.n() == 0) {
+            for (int id : ids) part[(size_t)id] = firstPart;
+            return;
+        }
+
+        std::mt19937 rng(seed);
+        int k0 = k / 2;
+        std::vector<char> side = bisect(w, (double)k0 / k, imbalance, options.threads, rng);
+
+        std::vector<int> local((size_t)w.n());
+        std::vector<int> m0, m1;
+        WGraph w0 = inducedSide(w, side, 0, local, m0);
+        WGraph w1 = inducedSide(w, side, 1, local, m1);
+        std::vector<int> ids0, ids1;
+        for (int v : m0) ids0.push_back(ids[(size_t)v]);
+        for (int v : m1) ids1.push_back(ids[(size_t)v]);
+
+        // halves write disjoint entries of part
+        if (w.n() >= SPLIT_IN_THREAD) {
+            std::thread left([&] { recurse(w0, ids0, firstPart, k0, imbalance, options, mix(seed * 2 + 1), part); });
+            recurse(w1, ids1, firstPart + k0, k - k0, imbalance, options, mix(seed * 2 + 2), part);
+            left.join();
+        }
+        else {
+            recurse(w0, ids0, firstPart, k0, imbalance, options, mix(seed * 2 + 1), part);
+            recurse(w1, ids1, firstPart + k0, k - k0, imbalance, options, mix(seed * 2 + 2), part);
+        }
+    }
+
+    // counting sort of the nodes with keep[v] by part
+    void groupByPart(const std::vector<int>& part, int parts, const std::vector<char>* keep,
+                     std::vector<int>& offsets, std::vector<int>& items) {
+        offsets.assign((size_t)parts + 1, 0);
+        for (size_t v = 0; v < part.size(); ++v) {
+            if (!keep || (*keep)[v]) ++offsets[(size_t)part[v] + 1];
+        }
+        for (int p = 0; p < parts; ++p) offsets[(size_t)p + 1] += offsets[(size_t)p];
+        items.resize((size_t)offsets[(size_t)parts]);
+        std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t v = 0; v < part.size(); ++v) {
+            if (!keep || (*keep)[v]) items[(size_t)cursor[(size_t)part[v]]++] = (int)v;
+        }
+    }
+}
+
+Partition GraphPartitioner::partition(const Graph& g, const PartitionOptions& options) {
+    if (options.parts < 1) throw std::runtime_error("GraphPartitioner: parts must be >= 1");
+
+    const int n = g.nodeCount();
+    Partition p;
+    p.parts = options.parts;
+    p.part.assign((size_t)n, 0);
+
+    WGraph w = fromGraph(g);
+    std::vector<int> ids((size_t)n);
+    for (int v = 0; v < n; ++v) ids[(size_t)v] = v;
+    int levels = 0;
+    while ((1 << levels) < options.parts) ++levels;
+    double perLevel = levels ? std::pow(1.0 + options.imbalance, 1.0 / levels) - 1.0 : options.imbalance;
+    recurse(w, ids, 0, options.parts, perLevel, options, options.seed, p.part);
+
+    std::vector<char> onBoundary((size_t)n, 0);
+    for (size_t id = 0; id < g.edges.size(); ++id) {
+        int a = g.edges.node_a[id];
+        int b = g.edges.node_b[id];
+        if (p.part[(size_t)a] == p.part[(size_t)b]) continue;
+        ++p.cut;
+        onBoundary[(size_t)a] = onBoundary[(size_t)b] = 1;
+    }
+    groupByPart(p.part, p.parts, nullptr, p.memberOffsets, p.members);
+    groupByPart(p.part, p.parts, &onBoundary, p.boundaryOffsets, p.boundary);
+
+    size_t largest = 0;
+    for (int q = 0; q < p.parts; ++q) largest = std::max(largest, p.nodesOf(q).size());
+    std::cout << "[GraphPartitioner] Parts=" << p.parts
+        << " Cut=" << p.cut
+        << " Boundary=" << p.boundary.size()
+        << " LargestPart=" << largest << "\n";
+    return p;
+}
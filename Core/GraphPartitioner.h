@@ -0,0 +1,42 @@
+﻿#pragma once
+#include "Graph.h"
+#include "NodeTypeIndex.h"
+#include <vector>
+
+struct PartitionOptions {
+    int parts = 2;
+    double imbalance = 0.03;   // a part may exceed n / parts by this fraction
+    int threads = 0;           // coarsening threads, 0: all hardware threads
+    unsigned seed = 1;
+};
+
+struct Partition {
+    int parts = 0;
+    std::vector<int> part;     // part[v] for every dense node index
+    long long cut = 0;         // edges whose ends are in different parts
+
+    // nodes of part p, ascending
+    NodeSpan nodesOf(int p) const { return span(memberOffsets, members, p); }
+
+    // nodes of part p with a neighbor in another part, ascending
+    NodeSpan boundaryOf(int p) const { return span(boundaryOffsets, boundary, p); }
+
+    std::vector<int> memberOffsets;
+    std::vector<int> members;
+    std::vector<int> boundaryOffsets;
+    std::vector<int> boundary;
+
+private:
+    static NodeSpan span(const std::vector<int>& offsets, const std::vector<int>& items, int p) {
+        return { items.data() + offsets[(size_t)p], items.data() + offsets[(size_t)p + 1] };
+    }
+};
+
+// Multilevel k-way partitioner in the METIS style, by recursive bisection.
+// Each bisection coarsens with heavy-edge matching (handshake rounds over
+// all threads, then contraction in parallel), bisects the coarsest graph by
+// greedy region growing and refines every level on the way back with FM.
+class GraphPartitioner {
+public:
+    static Partition partition(const Graph& g, const PartitionOptions& options = {});
+};
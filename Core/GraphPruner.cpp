@@ -0,0 +1,173 @@
+﻿#include "GraphPruner.h"
+#include "BlockCutTree.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // marks every node reachable from `from`
+    std::vector<char> reach(const Graph& g, int from) {
+        std::vector<char> seen((size_t)g.nodeCount(), 0);
+        std::vector<int> queue;
+        queue.reserve((size_t)g.nodeCount());
+        seen[(size_t)from] = 1;
+        queue.push_back(from);
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            for (int u : g.neighbors(queue[head])) {
+                if (seen[(size_t)u]) continue;
+                seen[(size_t)u] = 1;
+                queue.push_back(u);
+            }
+        }
+        return seen;
+    }
+}
+
+std::vector<int> PrunedGraph::toSource(const std::vector<int>& path) const {
+    std::vector<int> out;
+    out.reserve(path.size());
+    for (int v : path) out.push_back(origin[(size_t)v]);
+    return out;
+}
+
+std::vector<char> GraphPruner::routeNodes(const Graph& g, PruneStats* stats) {
+    PruneStats local;
+    PruneStats& st = stats ? *stats : local;
+    st = {};
+
+    const int n = g.nodeCount();
+    const int s = g.start_node;
+    const int t = g.end_node;
+    if (!g.hasNode(s) || !g.hasNode(t)) return std::vector<char>((size_t)n, 1);
+
+    // forward from start, backward from end; the adjacency is undirected, so
+    // both searches walk the same edges and the cut is their shared component
+    std::vector<char> keep = reach(g, s);
+    if (!keep[(size_t)t]) return std::vector<char>((size_t)n, 1);
+    std::vector<char> back = reach(g, t);
+    for (size_t v = 0; v < (size_t)n; ++v) {
+        if (keep[v] && back[v]) continue;
+        keep[v] = 0;
+        ++st.unreachable;
+    }
+
+    // peel: a node other than start/end with at most one live neighbor can
+    // only be entered and left through the same node, so no simple path uses it
+    std::vector<int> degree((size_t)n, 0);
+    std::vector<int> queue;
+    for (int v = 0; v < n; ++v) {
+        if (!keep[(size_t)v]) continue;
+        for (int u : g.neighbors(v)) degree[(size_t)v] += keep[(size_t)u] ? 1 : 0;
+        if (degree[(size_t)v] <= 1 && v != s && v != t) queue.push_back(v);
+    }
+
+    while (!queue.empty()) {
+        int v = queue.back();
+        queue.pop_back();
+        if (!keep[(size_t)v]) continue;
+        keep[(size_t)v] = 0;
+        ++st.deadEnds;
+
+        for (int u : g.neighbors(v)) {
+            if (!keep[(size_t)u]) continue;
+            if (--degree[(size_t)u] == 1 && u != s && u != t) queue.push_back(u);
+        }
+    }
+
+    // what is left may still hold cyclic dead ends behind a cut vertex
+    if (s == t) return keep;
+    BlockCutTree tree = BlockCutTree::build(g, s, &keep);
+    std::vector<char> onRoute((size_t)n, 0);
+    for (int b : tree.route(s, t)) {
+        for (const int* v = tree.blockBegin(b); v != tree.blockEnd(b); ++v) onRoute[(size_t)*v] = 1;
+    }
+    onRoute[(size_t)s] = onRoute[(size_t)t] = 1;
+    for (size_t v = 0; v < (size_t)n; ++v) {
+        if (!keep[v] || onRoute[v]) continue;
+        keep[v] = 0;
+        ++st.offRoute;
+    }
+    return keep;
+}
+
+Graph GraphPruner::subgraph(const Graph& g, const std::vector<char>& keep, std::vector<int>* origin) {
+    const int n = g.nodeCount();
+    std::vector<int> newIndex((size_t)n, -1);
+
+    Graph out;
+    for (int v = 0; v < n; ++v) {
+        if (!keep[(size_t)v]) continue;
+        newIndex[(size_t)v] = (int)out.nodes.size();
+        out.nodes.push_back(g.nodes[(size_t)v]);
+        if (origin) origin->push_back(v);
+    }
+
+    for (size_t id = 0; id < g.edges.size(); ++id) {
+        Edge e = g.edges[id];
+        int a = newIndex[(size_t)e.node_a];
+        int b = newIndex[(size_t)e.node_b];
+        if (a < 0 || b < 0) continue;
+        e.node_a = a;
+        e.node_b = b;
+        out.edges.push_back(e);
+    }
+
+    out.start_node = g.hasNode(g.start_node) ? std::max(0, newIndex[(size_t)g.start_node]) : 0;
+    out.end_node = g.hasNode(g.end_node) ? std::max(0, newIndex[(size_t)g.end_node]) : 0;
+    out.buildAdjacency(0, g.isCompressed());
+    if (g.isQuantized()) out.quantizeWeights();
+    return out;
+}
+
+PrunedGraph GraphPruner::prune(const Graph& g) {
+    PrunedGraph p;
+    std::vector<char> keep = routeNodes(g, &p.stats);
+    p.graph = subgraph(g, keep, &p.origin);
+
+    std::cout << "[GraphPruner] Nodes=" << g.nodeCount() << "->" << p.graph.nodeCount()
+        << " Edges=" << g.edges.size() << "->" << p.graph.edges.size()
+        << " Unreachable=" << p.stats.unreachable
+        << " DeadEnds=" << p.stats.deadEnds
+        << " OffRoute=" << p.stats.offRoute << "\n";
+    return p;
+}
+
+std::vector<PrunedGraph> GraphPruner::splitByBlocks(const Graph& g) {
+    std::vector<PrunedGraph> out;
+    if (!g.hasNode(g.start_node) || !g.hasNode(g.end_node)) return out;
+
+    BlockCutTree tree = BlockCutTree::build(g, g.start_node);
+    std::vector<int> joints;
+    std::vector<int> blocks = tree.route(g.start_node, g.end_node, &joints);
+
+    std::vector<char> keep((size_t)g.nodeCount(), 0);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const int* from = tree.blockBegin(blocks[i]);
+        const int* to = tree.blockEnd(blocks[i]);
+        for (const int* v = from; v != to; ++v) keep[(size_t)*v] = 1;
+
+        PrunedGraph p;
+        p.graph = subgraph(g, keep, &p.origin);
+        for (const int* v = from; v != to; ++v) keep[(size_t)*v] = 0;
+
+        // origin is ascending, so the local index is a binary search away
+        auto local = [&](int v) {
+            return (int)(std::lower_bound(p.origin.begin(), p.origin.end(), v) - p.origin.begin());
+        };
+        p.graph.start_node = local(i == 0 ? g.start_node : joints[i - 1]);
+        p.graph.end_node = local(i + 1 == blocks.size() ? g.end_node : joints[i]);
+        out.push_back(std::move(p));
+    }
+    return out;
+}
+
+std::vector<int> GraphPruner::joinBlocks(const std::vector<PrunedGraph>& blocks, const std::vector<std::vector<int>>& paths) {
+    std::vector<int> out;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (i >= paths.size() || paths[i].empty()) return {};
+        std::vector<int> piece = blocks[i].toSource(paths[i]);
+        // consecutive pieces share their joint
+        out.insert(out.end(), piece.begin() + (out.empty() ? 0 : 1), piece.end());
+    }
+    return out;
+}
@@ -0,0 +1,46 @@
+﻿#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <vector>
+
+struct PruneStats {
+    size_t unreachable = 0;   // not connected to both start and end
+    size_t deadEnds = 0;      // peeled off as dangling trees
+    size_t offRoute = 0;      // in blocks off the start->end block path
+};
+
+// Working graph for the solver plus the way back to the graph it came from
+struct PrunedGraph {
+    Graph graph;
+    std::vector<int> origin;   // origin[v] = index of v in the source graph
+    PruneStats stats;
+
+    // Maps a path over graph back to source-graph indices
+    std::vector<int> toSource(const std::vector<int>& path) const;
+};
+
+// Removes nodes that can never lie on a simple start->end path, so random
+// walks and repairs don't wander into them. Node::id is kept, so paths over
+// the pruned graph export with the file ids either way.
+class GraphPruner {
+public:
+    // keep[v] != 0 for nodes reachable from start and from end that survive
+    // peeling of dead-end trees (degree <= 1 chains hanging off the core) and
+    // lie in a biconnected block on the start->end block-cut tree path.
+    // Keeps everything if end is not reachable at all.
+    static std::vector<char> routeNodes(const Graph& g, PruneStats* stats = nullptr);
+
+    // Induced subgraph on keep[v] != 0; relative node and edge order is kept
+    static Graph subgraph(const Graph& g, const std::vector<char>& keep, std::vector<int>* origin = nullptr);
+
+    static PrunedGraph prune(const Graph& g);
+
+    // One sub-problem per block on the start->end block path, in route
+    // order: block i runs from the cut vertex it is entered by (start for
+    // the first) to the one it is left by (end for the last)
+    static std::vector<PrunedGraph> splitByBlocks(const Graph& g);
+
+    // Joins per-block paths (as solved on splitByBlocks' graphs) into one
+    // path over g; {} if any piece is missing
+    static std::vector<int> joinBlocks(const std::vector<PrunedGraph>& blocks, const std::vector<std::vector<int>>& paths);
+};
@@ -0,0 +1,215 @@
+﻿#include "GraphReorder.h"
+#include "NodeMarks.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+// Appends to `seq` the BFS order of the component of `root`;
+// neighbors are visited by increasing degree when byDegree is set.
+static void bfsAppend(const Graph& g, int root, bool byDegree, NodeMarks& seen, std::vector<int>& seq) {
+    size_t head = seq.size();
+    seq.push_back(root);
+    seen.set(root);
+
+    std::vector<int> next;
+    while (head < seq.size()) {
+        int v = seq[head++];
+        next.clear();
+        for (int to : g.neighbors(v)) {
+            if (!seen.testAndSet(to)) next.push_back(to);
+        }
+        if (byDegree) {
+            std::stable_sort(next.begin(), next.end(),
+                [&](int x, int y) { return g.degree(x) < g.degree(y); });
+        }
+        seq.insert(seq.end(), next.begin(), next.end());
+    }
+}
+
+static std::vector<int> bfsSequence(const Graph& g) {
+    const int n = g.nodeCount();
+    std::vector<int> seq;
+    seq.reserve((size_t)n);
+    NodeMarks seen;
+    seen.reset((size_t)n);
+
+    if (g.hasNode(g.start_node)) bfsAppend(g, g.start_node, false, seen, seq);
+    for (int v = 0; v < n; ++v) {
+        if (!seen.test(v)) bfsAppend(g, v, false, seen, seq);
+    }
+    return seq;
+}
+
+static std::vector<int> rcmSequence(const Graph& g) {
+    const int n = g.nodeCount();
+    std::vector<int> seq;
+    seq.reserve((size_t)n);
+    NodeMarks seen;
+    seen.reset((size_t)n);
+
+    // roots: lowest-degree unvisited node of every component
+    std::vector<int> byDegree((size_t)n);
+    std::iota(byDegree.begin(), byDegree.end(), 0);
+    std::stable_sort(byDegree.begin(), byDegree.end(),
+        [&](int x, int y) { return g.degree(x) < g.degree(y); });
+
+    for (int root : byDegree) {
+        if (!seen.test(root)) bfsAppend(g, root, true, seen, seq);
+    }
+    std::reverse(seq.begin(), seq.end());
+    return seq;
+}
+
+// Gorder's unit heap: keys only move by one, so every key keeps a doubly
+// linked list of its nodes and an update relinks a node in O(1). The top
+// key is walked down past emptied lists when popping.
+class UnitHeap {
+public:
+    explicit UnitHeap(int n) : key((size_t)n, 0), prev((size_t)n, -1), next((size_t)n, -1), head(1, -1) {
+        for (int v = n - 1; v >= 0; --v) link(v);
+    }
+
+    void add(int v, int delta) {
+        unlink(v);
+        key[(size_t)v] += delta;
+        if ((size_t)key[(size_t)v] >= head.size()) head.resize((size_t)key[(size_t)v] + 1, -1);
+        link(v);
+        top = std::max(top, key[(size_t)v]);
+    }
+
+    void remove(int v) { unlink(v); }
+
+    // a node of the largest key if that is above 0, else -1
+    int popMax() {
+        while (top > 0 && head[(size_t)top] < 0) --top;
+        if (top == 0) return -1;
+        int v = head[(size_t)top];
+        unlink(v);
+        return v;
+    }
+
+private:
+    std::vector<int> key;
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<int> head;   // first node of every key
+    int top = 0;
+
+    void link(int v) {
+        int& first = head[(size_t)key[(size_t)v]];
+        prev[(size_t)v] = -1;
+        next[(size_t)v] = first;
+        if (first >= 0) prev[(size_t)first] = v;
+        first = v;
+    }
+
+    void unlink(int v) {
+        int p = prev[(size_t)v];
+        int x = next[(size_t)v];
+        if (p >= 0) next[(size_t)p] = x;
+        else head[(size_t)key[(size_t)v]] = x;
+        if (x >= 0) prev[(size_t)x] = p;
+    }
+};
+
+static std::vector<int> gorderSequence(const Graph& g) {
+    // Greedy: place next the node sharing the most neighbor/sibling links
+    // with the last WINDOW placed nodes. Sibling expansion skips hubs so a
+    // step stays bounded on skewed degree distributions.
+    const int WINDOW = 5;
+    const int HUB_DEGREE = 256;
+    const int n = g.nodeCount();
+
+    std::vector<char> placed((size_t)n, 0);
+    UnitHeap heap(n);
+
+    // a node leaving the window takes back exactly what it gave, and only
+    // from nodes still unplaced, so no score goes below 0
+    auto bump = [&](int u, int delta) {
+        for (int x : g.neighbors(u)) {
+            if (!placed[(size_t)x]) heap.add(x, delta);
+            if (g.degree(x) > HUB_DEGREE) continue;
+            for (int y : g.neighbors(x)) {
+                if (y == u || placed[(size_t)y]) continue;
+                heap.add(y, delta);
+            }
+        }
+    };
+
+    std::vector<int> seq;
+    seq.reserve((size_t)n);
+    int scan = 0;   // fallback cursor for a fresh component
+
+    while ((int)seq.size() < n) {
+        int pick = heap.popMax();
+        if (pick < 0) {
+            if (seq.empty() && g.hasNode(g.start_node)) pick = g.start_node;
+            else {
+                while (placed[(size_t)scan]) ++scan;
+                pick = scan;
+            }
+            heap.remove(pick);
+        }
+
+        placed[(size_t)pick] = 1;
+        seq.push_back(pick);
+        bump(pick, +1);
+        if ((int)seq.size() > WINDOW) bump(seq[seq.size() - 1 - WINDOW], -1);
+    }
+    return seq;
+}
+
+std::vector<int> GraphReorder::permutation(const Graph& g, NodeOrder order) {
+    const int n = g.nodeCount();
+    std::vector<int> seq;
+
+    switch (order) {
+    case NodeOrder::BFS: seq = bfsSequence(g); break;
+    case NodeOrder::RCM: seq = rcmSequence(g); break;
+    case NodeOrder::Gorder: seq = gorderSequence(g); break;
+    case NodeOrder::None:
+        seq.resize((size_t)n);
+        std::iota(seq.begin(), seq.end(), 0);
+        break;
+    }
+
+    std::vector<int> newIndex((size_t)n);
+    for (int pos = 0; pos < n; ++pos) newIndex[(size_t)seq[(size_t)pos]] = pos;
+    return newIndex;
+}
+
+std::vector<int> GraphReorder::apply(Graph& g, NodeOrder order) {
+    std::vector<int> newIndex = permutation(g, order);
+    if (order == NodeOrder::None) return newIndex;
+
+    AlignedVector<Node> nodes(g.nodes.size());
+    for (size_t v = 0; v < g.nodes.size(); ++v) nodes[(size_t)newIndex[v]] = g.nodes[v];
+    g.nodes = std::move(nodes);
+
+    // relabel endpoints and sort edges by their new lower endpoint, so the
+    // weight columns are read in roughly the same order as the nodes
+    const EdgeList& in = g.edges;
+    std::vector<std::pair<std::pair<int, int>, size_t>> keys(in.size());
+    for (size_t id = 0; id < in.size(); ++id) {
+        int a = newIndex[(size_t)in.node_a[id]];
+        int b = newIndex[(size_t)in.node_b[id]];
+        keys[id] = { { std::min(a, b), std::max(a, b) }, id };
+    }
+    std::sort(keys.begin(), keys.end());
+
+    EdgeList edges;
+    edges.reserve(in.size());
+    for (const auto& k : keys) {
+        Edge e = in[k.second];
+        e.node_a = newIndex[(size_t)e.node_a];
+        e.node_b = newIndex[(size_t)e.node_b];
+        edges.push_back(e);
+    }
+    g.edges = std::move(edges);
+
+    g.start_node = newIndex[(size_t)g.start_node];
+    g.end_node = newIndex[(size_t)g.end_node];
+
+    g.buildAdjacency(0, g.isCompressed());
+    return newIndex;
+}
@@ -0,0 +1,22 @@
+﻿#pragma once
+#include "Graph.h"
+#include <vector>
+
+// Node relabeling for cache locality of neighbor traversals
+enum class NodeOrder {
+    None,
+    BFS,      // breadth-first from start_node, then remaining components
+    RCM,      // reverse Cuthill-McKee (bandwidth reduction)
+    Gorder    // greedy window ordering, Gorder-style (neighbors + siblings)
+};
+
+class GraphReorder {
+public:
+    // Computes newIndex[oldIndex] for the requested order
+    static std::vector<int> permutation(const Graph& g, NodeOrder order);
+
+    // Relabels nodes, edge endpoints and start/end, then rebuilds the
+    // adjacency on the same backend. Node::id is untouched, so exported paths keep the file ids.
+    // Returns newIndex[oldIndex] (identity for NodeOrder::None).
+    static std::vector<int> apply(Graph& g, NodeOrder order);
+};
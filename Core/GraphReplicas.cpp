@@ -0,0 +1,115 @@
+﻿#include "GraphReplicas.h"
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+    struct Topology {
+        std::vector<std::vector<int>> cpusOfNode;
+        std::vector<int> nodeOfCpu;
+    };
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+    std::vector<int> parseCpuList(const std::string& text) {
+        std::vector<int> cpus;
+        std::stringstream ss(text);
+        std::string part;
+        while (std::getline(ss, part, ',')) {
+            if (part.empty() || part == "\n") continue;
+            size_t dash = part.find('-');
+            int lo = std::stoi(part.substr(0, dash));
+            int hi = dash == std::string::npos ? lo : std::stoi(part.substr(dash + 1));
+            for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+        }
+        return cpus;
+    }
+
+    Topology probe() {
+        Topology t;
+#if defined(__linux__)
+        for (int node = 0; ; ++node) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!in) break;
+            std::string line;
+            std::getline(in, line);
+            t.cpusOfNode.push_back(parseCpuList(line));
+        }
+        for (size_t node = 0; node < t.cpusOfNode.size(); ++node) {
+            for (int cpu : t.cpusOfNode[node]) {
+                if ((size_t)cpu >= t.nodeOfCpu.size()) t.nodeOfCpu.resize((size_t)cpu + 1, 0);
+                t.nodeOfCpu[(size_t)cpu] = (int)node;
+            }
+        }
+#endif
+        if (t.cpusOfNode.empty()) t.cpusOfNode.emplace_back();
+        return t;
+    }
+
+    const Topology& topology() {
+        static const Topology t = probe();
+        return t;
+    }
+
+    std::atomic<bool> replicasOn{ true };
+}
+
+int Numa::nodeCount() {
+    return (int)topology().cpusOfNode.size();
+}
+
+int Numa::currentNode() {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    const auto& map = topology().nodeOfCpu;
+    if (cpu >= 0 && (size_t)cpu < map.size()) return map[(size_t)cpu];
+#endif
+    return 0;
+}
+
+bool Numa::bindThread(int node) {
+#if defined(__linux__)
+    const auto& t = topology();
+    if (node < 0 || (size_t)node >= t.cpusOfNode.size() || t.cpusOfNode[(size_t)node].empty()) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : t.cpusOfNode[(size_t)node]) CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+void Numa::setLocalReplicas(bool on) { replicasOn = on; }
+
+bool Numa::localReplicas() { return replicasOn; }
+
+GraphReplicas::GraphReplicas(std::shared_ptr<const Graph> source, bool enabled) {
+    int nodes = enabled ? Numa::nodeCount() : 1;
+    if (nodes <= 1) {
+        replicas.push_back(std::move(source));
+        return;
+    }
+
+    replicas.resize((size_t)nodes);
+    std::vector<std::thread> workers;
+    for (int node = 0; node < nodes; ++node) {
+        workers.emplace_back([this, node, &source] {
+            Numa::bindThread(node);
+            replicas[(size_t)node] = std::make_shared<const Graph>(source->clone());
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+const Graph& GraphReplicas::forNode(int node) const {
+    if (node < 0 || (size_t)node >= replicas.size()) node = 0;
+    return *replicas[(size_t)node];
+}
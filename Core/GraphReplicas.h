@@ -0,0 +1,36 @@
+﻿#pragma once
+#include "Graph.h"
+#include <memory>
+#include <vector>
+
+// NUMA topology helpers. Only Linux is probed (sysfs); elsewhere the host
+// is reported as a single node and binding is a no-op.
+namespace Numa {
+    int nodeCount();
+    int currentNode();          // node of the CPU the calling thread runs on
+    bool bindThread(int node);  // restrict the calling thread to that node's CPUs
+
+    // Whether the solver's worker pools (GA::runByBlocks) bind their workers
+    // to the nodes round-robin and solve on node-local copies (default on;
+    // nothing changes on a single-node host)
+    void setLocalReplicas(bool on);
+    bool localReplicas();
+}
+
+// One read-only graph copy per NUMA node. Each replica is deep-copied by a
+// thread bound to its node, so first touch places its pages locally;
+// workers bind themselves with Numa::bindThread and read local().
+// Disabled, or on a single-node host, every node maps to the source graph.
+class GraphReplicas {
+public:
+    explicit GraphReplicas(std::shared_ptr<const Graph> source, bool enabled = true);
+
+    int count() const { return (int)replicas.size(); }
+    bool replicated() const { return replicas.size() > 1; }
+
+    const Graph& forNode(int node) const;
+    const Graph& local() const { return forNode(Numa::currentNode()); }
+
+private:
+    std::vector<std::shared_ptr<const Graph>> replicas;
+};
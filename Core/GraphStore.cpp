@@ -0,0 +1,35 @@
+﻿#include "GraphStore.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+GraphStore::GraphStore(Graph initial)
+    : current(std::make_shared<const Graph>(std::move(initial))) {}
+
+std::shared_ptr<const Graph> GraphStore::pin() const {
+    return std::atomic_load(&current);
+}
+
+unsigned long long GraphStore::version() const {
+    return pin()->version;
+}
+
+unsigned long long GraphStore::publish(const std::vector<EdgeUpdate>& updates) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+
+    std::shared_ptr<const Graph> base = std::atomic_load(&current);
+    auto next = std::make_shared<Graph>(*base);
+    bool quantized = next->isQuantized();
+
+    for (const auto& u : updates) {
+        if (u.edge < 0 || (size_t)u.edge >= next->edges.size())
+            throw std::runtime_error("GraphStore: bad edge id " + std::to_string(u.edge));
+        next->setEdgeWeights(u.edge, u.latency, u.bandwidth);
+    }
+    if (quantized) next->quantizeWeights();
+    next->version = base->version + 1;
+
+    unsigned long long v = next->version;
+    std::atomic_store(&current, std::shared_ptr<const Graph>(std::move(next)));
+    return v;
+}
@@ -0,0 +1,36 @@
+﻿#pragma once
+#include "Graph.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct EdgeUpdate {
+    int edge = -1;            // edge id
+    double latency = 1.0;
+    double bandwidth = 1.0;
+};
+
+// Versioned, immutable graph snapshots (RCU style).
+// Readers pin() the current version and may use it for as long as they hold
+// the pointer, concurrently with writers. A writer copies the current
+// version (reference counts only, see CowArray.h), patches the edge weight
+// pages it touches and publishes the result. A version, and any page only it
+// references, is released when its last reader drops it.
+class GraphStore {
+public:
+    explicit GraphStore(Graph initial);
+
+    // Current snapshot; never modified after publication
+    std::shared_ptr<const Graph> pin() const;
+
+    unsigned long long version() const;
+
+    // Publishes a new version with the given edges changed. Writers are
+    // serialized among themselves, readers are never blocked.
+    // Returns the new version number.
+    unsigned long long publish(const std::vector<EdgeUpdate>& updates);
+
+private:
+    std::shared_ptr<const Graph> current;   // accessed via std::atomic_load/store only
+    std::mutex writerMutex;
+};
@@ -0,0 +1,84 @@
+﻿#pragma once
+#include "Graph.h"
+#include "NodeMarks.h"
+#include "Objective.h"
+#include <type_traits>
+
+// Non-owning, filtered view of a Graph for the searches in PathUtils.
+// Hidden nodes and edges are skipped while iterating, nothing is copied.
+// Masks are NodeMarks owned by the caller (reset to at least the node /
+// edge count); a null mask shows everything. A Graph converts to an
+// unfiltered view implicitly.
+struct GraphView {
+    const Graph& graph;
+    const NodeMarks* nodeMask = nullptr;   // visible nodes are the marked ones
+    const NodeMarks* edgeMask = nullptr;   // visible edges, by edge id
+    const EdgeList* weights = nullptr;     // latency/bandwidth override, by edge id
+
+    // endpoints of the searches that don't take explicit ones
+    int start_node;
+    int end_node;
+
+    GraphView(const Graph& source) : graph(source), start_node(source.start_node), end_node(source.end_node) {}
+
+    bool filtered() const { return nodeMask || edgeMask; }
+    bool hasNode(int v) const { return graph.hasNode(v) && (!nodeMask || nodeMask->test(v)); }
+    bool hasEdge(int e) const { return !edgeMask || edgeMask->test(e); }
+
+    double latency(int e) const { return (double)(weights ? weights : &graph.edges)->latency[(size_t)e]; }
+    double bandwidth(int e) const { return (double)(weights ? weights : &graph.edges)->bandwidth[(size_t)e]; }
+
+    // Objective::hopCost of edge e (Objective.h). The default objective
+    // reads the graph's precomputed cost unless the weights are overridden;
+    // the others combine the edge's hop terms.
+    template <class Objective = DefaultObjective>
+    double hopCost(int e) const {
+        HopTerms hop;
+        if (weights) hop = HopTerms::of(latency(e), bandwidth(e));
+        else if constexpr (std::is_same_v<Objective, DefaultObjective>) return graph.cost((size_t)e);
+        else hop = graph.hop((size_t)e);
+        return Objective::hopCost(hop.latency, hop.penalty);
+    }
+
+    // Neighbors of v that are visible along a visible edge
+    class Cursor {
+    public:
+        int target = -1;
+        int edge = -1;
+
+        bool next() {
+            while (c.next()) {
+                if (view->hasEdge(c.edge) && (!view->nodeMask || view->nodeMask->test(c.target))) {
+                    target = c.target;
+                    edge = c.edge;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        friend struct GraphView;
+        const GraphView* view = nullptr;
+        NeighborCursor c;
+    };
+
+    Cursor cursor(int v) const {
+        Cursor it;
+        it.view = this;
+        it.c = graph.cursor(v);
+        return it;
+    }
+
+    // -1 if a or b is hidden or no visible edge joins them
+    int findEdge(int a, int b) const {
+        if (!hasNode(a) || !hasNode(b)) return -1;
+        int e = graph.findEdge(a, b);
+        if (e < 0 || hasEdge(e)) return e;
+        // a hidden edge may shadow a visible parallel one
+        for (Cursor c = cursor(a); c.next();) {
+            if (c.target == b) return c.edge;
+        }
+        return -1;
+    }
+};
@@ -0,0 +1,97 @@
+﻿#include "HugePages.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <cstdlib>
+#endif
+
+namespace {
+#ifdef OPTNET_HUGE_PAGES
+    std::atomic<HugePageMode> currentMode{ HugePageMode::Transparent };
+#else
+    std::atomic<HugePageMode> currentMode{ HugePageMode::Off };
+#endif
+
+    enum class BlockKind { Thp, HugeTlb };
+
+    struct Block {
+        BlockKind kind;
+        size_t bytes;
+    };
+
+    // large blocks are few, a locked map is cheap enough to tell them apart on free
+    std::mutex registryMutex;
+    std::unordered_map<void*, Block> registry;
+    std::atomic<size_t> hugeTotal{ 0 };
+
+    void remember(void* p, BlockKind kind, size_t bytes) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry[p] = { kind, bytes };
+        hugeTotal += bytes;
+    }
+
+#if defined(__linux__)
+    constexpr size_t HUGE_PAGE = size_t(2) << 20;
+
+    size_t roundUp(size_t bytes) { return (bytes + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1); }
+
+    void* allocHugeTlb(size_t bytes) {
+        void* p = mmap(nullptr, roundUp(bytes), PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    void* allocThp(size_t bytes) {
+        void* p = nullptr;
+        if (posix_memalign(&p, HUGE_PAGE, roundUp(bytes)) != 0) return nullptr;
+        madvise(p, roundUp(bytes), MADV_HUGEPAGE);
+        return p;
+    }
+#endif
+}
+
+void HugePages::setMode(HugePageMode mode) { currentMode = mode; }
+
+HugePageMode HugePages::mode() { return currentMode; }
+
+size_t HugePages::hugeBytes() { return hugeTotal; }
+
+void* HugePages::allocate(size_t bytes, size_t align) {
+#if defined(__linux__)
+    HugePageMode m = currentMode;
+    if (bytes >= THRESHOLD && m != HugePageMode::Off) {
+        if (m == HugePageMode::Explicit) {
+            if (void* p = allocHugeTlb(bytes)) { remember(p, BlockKind::HugeTlb, bytes); return p; }
+        }
+        if (void* p = allocThp(bytes)) { remember(p, BlockKind::Thp, bytes); return p; }
+    }
+#endif
+    return ::operator new(bytes, std::align_val_t(align));
+}
+
+void HugePages::deallocate(void* p, size_t bytes, size_t align) noexcept {
+    if (!p) return;
+#if defined(__linux__)
+    if (bytes >= THRESHOLD) {
+        std::unique_lock<std::mutex> lock(registryMutex);
+        auto it = registry.find(p);
+        if (it != registry.end()) {
+            Block b = it->second;
+            registry.erase(it);
+            hugeTotal -= b.bytes;
+            lock.unlock();
+
+            if (b.kind == BlockKind::HugeTlb) munmap(p, roundUp(b.bytes));
+            else std::free(p);
+            return;
+        }
+    }
+#else
+    (void)bytes;
+#endif
+    ::operator delete(p, std::align_val_t(align));
+}
@@ -0,0 +1,26 @@
+﻿#pragma once
+#include <cstddef>
+
+// Backing pages for large graph arrays
+enum class HugePageMode {
+    Off,            // regular aligned operator new
+    Transparent,    // 2 MB aligned + madvise(MADV_HUGEPAGE) (Linux THP)
+    Explicit        // mmap(MAP_HUGETLB) from the reserved pool, THP if that fails
+};
+
+// Used by AlignedAllocator for every graph array. Blocks below THRESHOLD
+// always come from operator new; larger ones follow the current mode.
+// Only Linux honors Transparent/Explicit, elsewhere they act as Off.
+namespace HugePages {
+    constexpr size_t THRESHOLD = size_t(2) << 20;
+
+    // Applies to allocations made afterwards (default: OPTNET_HUGE_PAGES build option)
+    void setMode(HugePageMode mode);
+    HugePageMode mode();
+
+    void* allocate(size_t bytes, size_t align);
+    void deallocate(void* p, size_t bytes, size_t align) noexcept;
+
+    // bytes currently held in huge-page backed blocks
+    size_t hugeBytes();
+}
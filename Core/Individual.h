@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+
+struct PathSums;
+
+// The genome is the start node and the edge ids walked from it, so scoring
+// and validity checks gather from the edge columns without edge lookups.
+// path is the node sequence, decoded from the genome for output.
+struct Individual {
+    int start = -1;
+    std::vector<int> edges;
+    std::vector<int> path;
+    double fitness = 1e18;
+
+    // One value per criterion in multi-objective mode (GA::runPareto)
+    std::vector<double> criteria;
+
+    // Running sums of the walk (Fitness.h), kept with incremental scoring
+    // (GA::setIncrementalFitness); null otherwise or after an edit that
+    // didn't update them
+    std::shared_ptr<const PathSums> sums;
+};
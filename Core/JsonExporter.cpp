@@ -0,0 +1,73 @@
+﻿#include "JsonExporter.h"
+#include <fstream>
+#include <iostream>
+
+static const char* nodeTypeToString(NodeType t) {
+    switch (t) {
+    case NodeType::PC: return "PC";
+    case NodeType::COMPUTE: return "COMPUTE";
+    case NodeType::SERVER: return "SERVER";
+    case NodeType::STORAGE: return "STORAGE";
+    case NodeType::GATEWAY: return "GATEWAY";
+    case NodeType::UNKNOWN: break;
+    }
+    return "UNKNOWN";
+}
+
+void JsonExporter::exportGraph(const Graph& g, const std::string& outPath) {
+    std::ofstream out(outPath);
+    if (!out) {
+        std::cerr << "[JsonExporter] Failed to write graph: " << outPath << "\n";
+        return;
+    }
+
+    out << "{\n";
+    out << "\"start_node\": " << g.nodes[(size_t)g.start_node].id << ",\n";
+    out << "\"end_node\": " << g.nodes[(size_t)g.end_node].id << ",\n";
+
+    out << "\"nodes\": [\n";
+    bool first = true;
+    for (const auto& n : g.nodes) {
+        if (!first) out << ",\n";
+        first = false;
+        out << "  { \"id\": " << n.id
+            << ", \"type\": \"" << nodeTypeToString(n.type)
+            << "\", \"performance\": " << n.performance << " }";
+    }
+    out << "\n],\n";
+
+    out << "\"edges\": [\n";
+    first = true;
+    for (size_t id = 0; id < g.edges.size(); ++id) {
+        const Edge e = g.edges[id];
+        if (!first) out << ",\n";
+        first = false;
+        out << "  { \"node_a\": " << g.nodes[(size_t)e.node_a].id
+            << ", \"node_b\": " << g.nodes[(size_t)e.node_b].id
+            << ", \"latency\": " << e.latency
+            << ", \"bandwidth\": " << e.bandwidth << " }";
+    }
+    out << "\n]\n}\n";
+
+    std::cout << "[JsonExporter] Graph saved to " << outPath << "\n";
+}
+
+void JsonExporter::exportPath(const Graph& g, const std::vector<int>& path, double fitness, const std::string& outPath) {
+    std::ofstream out(outPath, std::ios::binary);
+    if (!out) {
+        std::cerr << "[JsonExporter] Failed to write best path: " << outPath << "\n";
+        return;
+    }
+
+    out << "{\n";
+    out << "  \"fitness\": " << fitness << ",\n";
+    out << "  \"path\": [";
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (i) out << ", ";
+        out << g.nodes[(size_t)path[i]].id;
+    }
+    out << "]\n";
+    out << "}\n";
+
+    std::cout << "[JsonExporter] Best path saved to " << outPath << "\n";
+}
@@ -0,0 +1,13 @@
+﻿#pragma once
+#include "Graph.h"
+#include <vector>
+#include <string>
+
+class JsonExporter {
+public:
+    // Topology in the format GraphLoader reads (original node ids)
+    static void exportGraph(const Graph& g, const std::string& outPath);
+
+    // path holds dense indices; the original node ids are written
+    static void exportPath(const Graph& g, const std::vector<int>& path, double fitness, const std::string& outPath);
+};
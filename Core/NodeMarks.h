@@ -0,0 +1,31 @@
+﻿#pragma once
+#include <vector>
+#include <algorithm>
+
+// Visited set over dense node indices. reset() is O(1) amortized:
+// it bumps a stamp instead of clearing the array.
+class NodeMarks {
+public:
+    void reset(size_t n) {
+        if (mark.size() < n) mark.resize(n, 0);
+        if (++stamp == 0) {
+            std::fill(mark.begin(), mark.end(), 0u);
+            stamp = 1;
+        }
+    }
+
+    bool test(int v) const { return mark[(size_t)v] == stamp; }
+    void set(int v) { mark[(size_t)v] = stamp; }
+    void unset(int v) { mark[(size_t)v] = 0; }
+
+    // returns true if v was already marked
+    bool testAndSet(int v) {
+        if (mark[(size_t)v] == stamp) return true;
+        mark[(size_t)v] = stamp;
+        return false;
+    }
+
+private:
+    std::vector<unsigned> mark;
+    unsigned stamp = 0;
+};
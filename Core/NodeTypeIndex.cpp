@@ -0,0 +1,29 @@
+﻿#include "NodeTypeIndex.h"
+
+NodeTypeIndex NodeTypeIndex::build(const CowVector<Node>& nodes) {
+    const size_t n = nodes.size();
+    NodeTypeIndex idx;
+    idx.bitmaps.assign((size_t)NODE_TYPE_COUNT, NodeBitmap(n));
+
+    for (size_t v = 0; v < n; ++v) {
+        size_t t = (size_t)nodes[v].type;
+        idx.bitmaps[t].set((int)v);
+        ++idx.offsets[t + 1];
+    }
+    for (int t = 0; t < NODE_TYPE_COUNT; ++t) idx.offsets[t + 1] += idx.offsets[t];
+
+    // counting sort; ascending within a type
+    idx.byType.resize(n);
+    int cursor[NODE_TYPE_COUNT];
+    for (int t = 0; t < NODE_TYPE_COUNT; ++t) cursor[t] = idx.offsets[t];
+    for (size_t v = 0; v < n; ++v) idx.byType[(size_t)cursor[(size_t)nodes[v].type]++] = (int)v;
+    return idx;
+}
+
+NodeBitmap NodeTypeIndex::mask(unsigned typeBits) const {
+    NodeBitmap out(byType.size());
+    for (int t = 0; t < NODE_TYPE_COUNT; ++t) {
+        if (typeBits & (1u << t)) out |= bitmaps[(size_t)t];
+    }
+    return out;
+}
@@ -0,0 +1,66 @@
+﻿#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+
+constexpr int NODE_TYPE_COUNT = (int)NodeType::UNKNOWN + 1;
+
+inline unsigned typeBit(NodeType t) { return 1u << (unsigned)t; }
+
+// Bit per dense node index
+class NodeBitmap {
+public:
+    explicit NodeBitmap(size_t n = 0) : words((n + 63) / 64, 0) {}
+
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+    bool test(int v) const { return (words[(size_t)v >> 6] >> ((unsigned)v & 63)) & 1; }
+    void set(int v) { words[(size_t)v >> 6] |= uint64_t(1) << ((unsigned)v & 63); }
+
+    NodeBitmap& operator|=(const NodeBitmap& o) {
+        for (size_t i = 0; i < words.size() && i < o.words.size(); ++i) words[i] |= o.words[i];
+        return *this;
+    }
+
+private:
+    AlignedVector<uint64_t> words;
+};
+
+// Contiguous run of dense node indices, ascending
+struct NodeSpan {
+    const int* first = nullptr;
+    const int* last = nullptr;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    size_t size() const { return (size_t)(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](size_t i) const { return first[i]; }
+};
+
+// Per-NodeType membership, rebuilt with the adjacency: one bitmap per type
+// for constant-time checks and the nodes grouped by type for listing
+class NodeTypeIndex {
+public:
+    static NodeTypeIndex build(const CowVector<Node>& nodes);
+
+    bool is(int v, NodeType t) const { return bitmaps[(size_t)t].test(v); }
+    const NodeBitmap& bitmap(NodeType t) const { return bitmaps[(size_t)t]; }
+
+    // union of the bitmaps of every type in typeBits
+    NodeBitmap mask(unsigned typeBits) const;
+
+    NodeSpan of(NodeType t) const {
+        return { byType.data() + offsets[(size_t)t], byType.data() + offsets[(size_t)t + 1] };
+    }
+    size_t count(NodeType t) const { return of(t).size(); }
+
+    size_t bytes() const {
+        return bitmaps.size() * bitmaps.front().bytes() + byType.size() * sizeof(int);
+    }
+
+private:
+    std::vector<NodeBitmap> bitmaps;
+    int offsets[NODE_TYPE_COUNT + 1] = {};
+    AlignedVector<int> byType;   // node indices grouped by type
+};
@@ -0,0 +1,145 @@
+﻿#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// What a walk adds up to; the objective terms score these
+struct PathTotals {
+    double latency = 0.0;   // clamped hop latencies
+    double penalty = 0.0;   // latency / bandwidth per hop
+    double perf = 0.0;      // node performance over all visits
+    double loops = 0.0;     // repeated visits
+    size_t nodes = 0;
+};
+
+// Parts of the walk a term reads. The fitness kernels only gather and sum
+// what some term of the objective needs.
+enum ObjectiveNeeds : unsigned {
+    NEEDS_HOPS = 1,      // per-edge latency and penalty
+    NEEDS_PERF = 2,      // node performance
+    NEEDS_LOOPS = 4      // revisit check
+};
+
+// Objective terms. Each one has a compile-time weight Num / Den, the total
+// it contributes for a whole walk (value) and for one hop over an edge
+// (hop, used by the cheapest-path search; 0 if the term is not per hop).
+// A term grows if its value can only rise as a walk goes on; the others
+// give floor(perfCeiling), the least value they can take on any walk.
+template <int Num, int Den = 1>
+struct LatencyTerm {
+    static constexpr double weight = (double)Num / Den;
+    static constexpr unsigned needs = NEEDS_HOPS;
+    static double value(const PathTotals& t) { return t.latency; }
+    static double hop(double latency, double) { return latency; }
+    static constexpr bool grows = true;
+};
+
+template <int Num, int Den = 1>
+struct HopsTerm {
+    static constexpr double weight = (double)Num / Den;
+    static constexpr unsigned needs = 0;
+    static double value(const PathTotals& t) { return (double)(t.nodes - 1); }
+    static double hop(double, double) { return 1.0; }
+    static constexpr bool grows = true;
+};
+
+// prefers bigger bandwidth: latency / bandwidth grows as it shrinks
+template <int Num, int Den = 1>
+struct BandwidthTerm {
+    static constexpr double weight = (double)Num / Den;
+    static constexpr unsigned needs = NEEDS_HOPS;
+    static double value(const PathTotals& t) { return t.penalty; }
+    static double hop(double, double penalty) { return penalty; }
+    static constexpr bool grows = true;
+};
+
+// 50 per repeated visit
+template <int Num, int Den = 1>
+struct LoopTerm {
+    static constexpr double weight = (double)Num / Den;
+    static constexpr unsigned needs = NEEDS_LOOPS;
+    static double value(const PathTotals& t) { return 50.0 * t.loops; }
+    static double hop(double, double) { return 0.0; }
+    static constexpr bool grows = true;
+};
+
+// Bonus (subtracted) for high average node performance, bounded by the
+// log so it doesn't dominate
+template <int Num, int Den = 1>
+struct PerfTerm {
+    static constexpr double weight = (double)Num / Den;
+    static constexpr unsigned needs = NEEDS_PERF;
+    static double value(const PathTotals& t) {
+        double perfAvg = t.perf / std::max<size_t>(1, t.nodes);
+        return -(std::log1p(std::max(0.0, perfAvg)) * 2.0);
+    }
+    static double hop(double, double) { return 0.0; }
+    // no average can beat the best node
+    static constexpr bool grows = false;
+    static double floor(double perfCeiling) {
+        return -(std::log1p(std::max(0.0, perfCeiling)) * 2.0);
+    }
+};
+
+// A fitness objective: the weighted sum of its terms, lower is better.
+// BasicFitness and BasicGA are instantiated per objective, so terms it
+// doesn't list cost nothing at run time.
+template <class... Terms>
+struct Objective {
+    static_assert(((Terms::weight >= 0.0) && ...), "the score bounds assume non-negative weights");
+
+    static constexpr unsigned needs = (0u | ... | Terms::needs);
+
+    // terms are added in the order listed
+    static double combine(const PathTotals& t) {
+        return (0.0 + ... + (Terms::weight * Terms::value(t)));
+    }
+
+    // Score bounds for early abort: grown() adds up the growing terms from
+    // the sums of a walk's prefix (t.nodes its full length), floorRest() the
+    // least the other terms can add given the largest node performance. No
+    // walk with that prefix scores below their sum.
+    static double grown(const PathTotals& partial) {
+        return (0.0 + ... + grownPart<Terms>(partial));
+    }
+    static double floorRest(double perfCeiling) {
+        return (0.0 + ... + floorPart<Terms>(perfCeiling));
+    }
+
+    // what one hop over an edge adds (latency and penalty already clamped):
+    // the terms that depend on the edge first, then the constant ones
+    static double hopCost(double latency, double penalty) {
+        double edge = (0.0 + ... + (Terms::needs != 0 ? Terms::weight * Terms::hop(latency, penalty) : 0.0));
+        double fixed = (0.0 + ... + (Terms::needs == 0 ? Terms::weight * Terms::hop(latency, penalty) : 0.0));
+        return edge + fixed;
+    }
+
+private:
+    template <class Term>
+    static double grownPart(const PathTotals& t) {
+        if constexpr (Term::grows) return Term::weight * Term::value(t);
+        else return 0.0;
+    }
+
+    template <class Term>
+    static double floorPart(double perfCeiling) {
+        if constexpr (Term::grows) return 0.0;
+        else return Term::weight * Term::floor(perfCeiling);
+    }
+};
+
+// The balanced objective the solver has always used
+using DefaultObjective = Objective<LatencyTerm<1>, HopsTerm<5, 2>, BandwidthTerm<25>, LoopTerm<1>, PerfTerm<1>>;
+
+// Lowest end-to-end latency
+using LatencyObjective = Objective<LatencyTerm<1>, LoopTerm<1>>;
+
+// Widest links: least latency / bandwidth, ties to fewer hops
+using BandwidthObjective = Objective<BandwidthTerm<1>, HopsTerm<1, 100>, LoopTerm<1>>;
+
+// Every prebuilt objective as X(type, name); BasicFitness and BasicGA are
+// explicitly instantiated for these and ObjectiveRegistry lists them
+#define OPTNET_OBJECTIVES(X) \
+    X(DefaultObjective, "default") \
+    X(LatencyObjective, "latency") \
+    X(BandwidthObjective, "bandwidth")
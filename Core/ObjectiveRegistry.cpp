@@ -0,0 +1,45 @@
+﻿#include "ObjectiveRegistry.h"
+#include "GA.h"
+#include <stdexcept>
+
+template <class Objective>
+static ObjectiveEntry entry(const char* name) {
+    return {
+        name,
+        [](const Graph& g, const RoutePolicy& policy) {
+            BasicGA<Objective> ga(g);
+            ga.setRoutePolicy(policy);
+            return ga.run();
+        },
+        [](const Graph& g, bool parallel) { return BasicGA<Objective>::runByBlocks(g, parallel); },
+        [](const Graph& g, const RoutePolicy& policy) {
+            BasicGA<Objective> ga(g);
+            ga.setRoutePolicy(policy);
+            return ga.runPareto();
+        },
+        [](const Graph& g, const std::vector<int>& path) { return BasicFitness<Objective>::evaluate(g, path); },
+        [](const Graph& g, int start, const std::vector<int>& edges) {
+            return BasicFitness<Objective>::evaluate(g, start, edges);
+        }
+    };
+}
+
+const std::vector<ObjectiveEntry>& ObjectiveRegistry::all() {
+#define OPTNET_REGISTER_OBJECTIVE(Objective, name) entry<Objective>(name),
+    static const std::vector<ObjectiveEntry> entries = { OPTNET_OBJECTIVES(OPTNET_REGISTER_OBJECTIVE) };
+#undef OPTNET_REGISTER_OBJECTIVE
+    return entries;
+}
+
+const ObjectiveEntry& ObjectiveRegistry::find(const std::string& name) {
+    std::string known;
+    for (const auto& e : all()) {
+        if (name == e.name) return e;
+        known += known.empty() ? e.name : std::string(", ") + e.name;
+    }
+    throw std::runtime_error("unknown objective '" + name + "' (known: " + known + ")");
+}
+
+const ObjectiveEntry& ObjectiveRegistry::standard() {
+    return find("default");
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+#include "Graph.h"
+#include "Individual.h"
+#include "RoutePolicy.h"
+#include <string>
+#include <vector>
+
+// One prebuilt objective: entry points into its BasicGA / BasicFitness
+// instantiation, so the choice costs one indirect call per run, not per hop
+struct ObjectiveEntry {
+    const char* name;
+    Individual (*run)(const Graph& g, const RoutePolicy& policy);
+    Individual (*runByBlocks)(const Graph& g, bool parallel);
+    std::vector<Individual> (*runPareto)(const Graph& g, const RoutePolicy& policy);   // default criteria
+    double (*evaluate)(const Graph& g, const std::vector<int>& path);
+    double (*evaluateEdges)(const Graph& g, int start, const std::vector<int>& edges);
+};
+
+// The objectives of OPTNET_OBJECTIVES (Objective.h), selectable by name
+// at startup. Adding one there adds it here.
+class ObjectiveRegistry {
+public:
+    static const std::vector<ObjectiveEntry>& all();
+
+    // Throws std::runtime_error listing the known names if there is no such objective
+    static const ObjectiveEntry& find(const std::string& name);
+
+    // "default", the objective GA and Fitness stand for
+    static const ObjectiveEntry& standard();
+};
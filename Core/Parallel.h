@@ -0,0 +1,32 @@
+﻿#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Fork/join helpers for the bulk graph passes
+namespace Parallel {
+    // below this many items a pass runs on the calling thread
+    constexpr size_t SERIAL_BELOW = size_t(1) << 15;
+
+    // requested <= 0 means all hardware threads
+    inline int threadCount(int requested, size_t work) {
+        if (work < SERIAL_BELOW) return 1;
+        int t = requested > 0 ? requested : (int)std::thread::hardware_concurrency();
+        return std::max(1, t);
+    }
+
+    // fn(begin, end, threadIndex) over `threads` contiguous chunks of [0, n)
+    template <class Fn>
+    void chunks(size_t n, int threads, Fn fn) {
+        if (threads <= 1) { fn((size_t)0, n, 0); return; }
+        std::vector<std::thread> pool;
+        size_t chunk = (n + (size_t)threads - 1) / (size_t)threads;
+        for (int t = 0; t < threads; ++t) {
+            size_t b = std::min(n, chunk * (size_t)t);
+            size_t e = std::min(n, b + chunk);
+            pool.emplace_back(fn, b, e, t);
+        }
+        for (auto& th : pool) th.join();
+    }
+}
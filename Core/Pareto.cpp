@@ -0,0 +1,228 @@
+﻿#include "Pareto.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // Distinct points in lexicographic order. A point can only be dominated
+    // by one before it there, so every front follows from earlier ranks:
+    // rank = 1 + the highest rank of any point dominating it.
+    struct Sorted {
+        const double* values;
+        size_t m;
+        std::vector<int> order;    // one original index per distinct point
+
+        const double* row(int k) const { return values + (size_t)order[(size_t)k] * m; }
+        double at(int k, size_t j) const { return row(k)[j]; }
+    };
+
+    // earlier point q dominates later p on objectives 1..m-1
+    bool dominatesRest(const Sorted& s, int q, int p) {
+        const double* a = s.row(q);
+        const double* b = s.row(p);
+        for (size_t j = 1; j < s.m; ++j) {
+            if (a[j] > b[j]) return false;
+        }
+        return true;
+    }
+
+    // 2 objectives: the smallest second value of each front so far rises
+    // with the front, so a binary search finds the first not dominating p
+    void sweep2(const Sorted& s, std::vector<int>& r) {
+        std::vector<double> frontMin;
+        for (int p = 0; p < (int)r.size(); ++p) {
+            double f1 = s.at(p, 1);
+            size_t k = (size_t)(std::upper_bound(frontMin.begin(), frontMin.end(), f1) - frontMin.begin());
+            if (k == frontMin.size()) frontMin.push_back(f1);
+            else frontMin[k] = f1;
+            r[(size_t)p] = (int)k;
+        }
+    }
+
+    // Max over a prefix of the (compressed) third objective
+    class MaxTree {
+    public:
+        explicit MaxTree(size_t n) : tree(n + 1, -1) {}
+
+        void raise(size_t at, int value) {
+            for (size_t x = at; x < tree.size(); x += x & (~x + 1)) tree[x] = std::max(tree[x], value);
+        }
+        void clear(size_t at) {
+            for (size_t x = at; x < tree.size() && tree[x] != -1; x += x & (~x + 1)) tree[x] = -1;
+        }
+        int prefix(size_t at) const {
+            int best = -1;
+            for (size_t x = at; x > 0; x -= x & (~x + 1)) best = std::max(best, tree[x]);
+            return best;
+        }
+
+    private:
+        std::vector<int> tree;
+    };
+
+    // 3 objectives: the first is taken care of by the order, so [l, mid)
+    // passes its ranks to [mid, r) by a sweep over the second objective
+    // with a max tree over the third. The left half is finished before the
+    // pass and the right half solved after it.
+    struct Divide3 {
+        const Sorted& s;
+        std::vector<int>& r;
+        std::vector<size_t> third;   // 1-based rank of the third objective
+        MaxTree tree;
+        std::vector<int> left;
+        std::vector<int> right;
+
+        Divide3(const Sorted& sorted, std::vector<int>& ranks)
+            : s(sorted), r(ranks), third(ranks.size()), tree(ranks.size()) {
+            std::vector<double> values(r.size());
+            for (size_t p = 0; p < r.size(); ++p) values[p] = s.at((int)p, 2);
+            std::sort(values.begin(), values.end());
+            for (size_t p = 0; p < r.size(); ++p)
+                third[p] = (size_t)(std::lower_bound(values.begin(), values.end(), s.at((int)p, 2)) - values.begin()) + 1;
+        }
+
+        void solve(int l, int h) {
+            if (h - l <= 16) {
+                for (int p = l + 1; p < h; ++p) {
+                    for (int q = l; q < p; ++q) {
+                        if (r[(size_t)q] >= r[(size_t)p] && dominatesRest(s, q, p)) r[(size_t)p] = r[(size_t)q] + 1;
+                    }
+                }
+                return;
+            }
+            int mid = l + (h - l) / 2;
+            solve(l, mid);
+            pass(l, mid, h);
+            solve(mid, h);
+        }
+
+        void pass(int l, int mid, int h) {
+            auto bySecond = [this](int a, int b) { return s.at(a, 1) < s.at(b, 1); };
+            left.resize((size_t)(mid - l));
+            right.resize((size_t)(h - mid));
+            std::iota(left.begin(), left.end(), l);
+            std::iota(right.begin(), right.end(), mid);
+            std::sort(left.begin(), left.end(), bySecond);
+            std::sort(right.begin(), right.end(), bySecond);
+
+            size_t i = 0;
+            for (int p : right) {
+                // ties on the second objective still dominate
+                for (; i < left.size() && s.at(left[i], 1) <= s.at(p, 1); ++i)
+                    tree.raise(third[(size_t)left[i]], r[(size_t)left[i]]);
+                int best = tree.prefix(third[(size_t)p]);
+                if (best >= r[(size_t)p]) r[(size_t)p] = best + 1;
+            }
+            for (size_t k = 0; k < i; ++k) tree.clear(third[(size_t)left[k]]);
+        }
+    };
+}
+
+std::vector<int> ParetoSort::rank(const std::vector<double>& values, size_t m) {
+    const size_t n = m ? values.size() / m : 0;
+    std::vector<int> ranks(n, 0);
+    if (n == 0) return ranks;
+
+    auto row = [&](int i) { return values.data() + (size_t)i * m; };
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return std::lexicographical_compare(row(a), row(a) + m, row(b), row(b) + m);
+    });
+
+    // equal points share one entry
+    Sorted s{ values.data(), m, {} };
+    std::vector<int> entry(n);
+    for (int i : order) {
+        if (s.order.empty() || !std::equal(row(i), row(i) + m, row(s.order.back()))) s.order.push_back(i);
+        entry[(size_t)i] = (int)s.order.size() - 1;
+    }
+
+    std::vector<int> r(s.order.size(), 0);
+    if (m == 1) {
+        std::iota(r.begin(), r.end(), 0);
+    }
+    else if (m == 2) {
+        sweep2(s, r);
+    }
+    else if (m == 3) {
+        Divide3 d(s, r);
+        d.solve(0, (int)r.size());
+    }
+    else {
+        for (int p = 1; p < (int)r.size(); ++p) {
+            for (int q = 0; q < p; ++q) {
+                if (r[(size_t)q] >= r[(size_t)p] && dominatesRest(s, q, p)) r[(size_t)p] = r[(size_t)q] + 1;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) ranks[i] = r[(size_t)entry[i]];
+    return ranks;
+}
+
+std::vector<int> ParetoSort::rankNaive(const std::vector<double>& values, size_t m) {
+    const size_t n = m ? values.size() / m : 0;
+    auto dominates = [&](size_t a, size_t b) {
+        bool better = false;
+        for (size_t j = 0; j < m; ++j) {
+            double x = values[a * m + j];
+            double y = values[b * m + j];
+            if (x > y) return false;
+            if (x < y) better = true;
+        }
+        return better;
+    };
+
+    // who each point dominates, and by how many it is dominated
+    std::vector<std::vector<size_t>> beats(n);
+    std::vector<int> beaten(n, 0);
+    for (size_t a = 0; a < n; ++a) {
+        for (size_t b = a + 1; b < n; ++b) {
+            if (dominates(a, b)) { beats[a].push_back(b); ++beaten[b]; }
+            else if (dominates(b, a)) { beats[b].push_back(a); ++beaten[a]; }
+        }
+    }
+
+    std::vector<int> ranks(n, 0);
+    std::vector<size_t> front;
+    for (size_t a = 0; a < n; ++a) {
+        if (beaten[a] == 0) front.push_back(a);
+    }
+    for (int k = 0; !front.empty(); ++k) {
+        std::vector<size_t> next;
+        for (size_t a : front) {
+            ranks[a] = k;
+            for (size_t b : beats[a]) {
+                if (--beaten[b] == 0) next.push_back(b);
+            }
+        }
+        front.swap(next);
+    }
+    return ranks;
+}
+
+std::vector<double> ParetoSort::crowding(const std::vector<double>& values, size_t m, const std::vector<int>& ranks) {
+    const size_t n = ranks.size();
+    std::vector<double> distance(n, 0.0);
+    if (n == 0) return distance;
+
+    std::vector<std::vector<size_t>> fronts((size_t)*std::max_element(ranks.begin(), ranks.end()) + 1);
+    for (size_t i = 0; i < n; ++i) fronts[(size_t)ranks[i]].push_back(i);
+
+    const double inf = std::numeric_limits<double>::infinity();
+    for (auto& front : fronts) {
+        for (size_t j = 0; j < m; ++j) {
+            auto value = [&](size_t i) { return values[i * m + j]; };
+            std::sort(front.begin(), front.end(), [&](size_t a, size_t b) { return value(a) < value(b); });
+
+            distance[front.front()] = inf;
+            distance[front.back()] = inf;
+            double span = value(front.back()) - value(front.front());
+            if (span <= 0.0) continue;
+            for (size_t k = 1; k + 1 < front.size(); ++k)
+                distance[front[k]] += (value(front[k + 1]) - value(front[k - 1])) / span;
+        }
+    }
+    return distance;
+}
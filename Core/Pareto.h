@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <cstddef>
+#include <vector>
+
+// Non-dominated sorting and crowding distance for multi-objective search
+// (NSGA-II). All objectives are minimized. With m objectives, point i is
+// values[i * m .. i * m + m).
+class ParetoSort {
+public:
+    // Front of every point: 0 if no other point dominates it, k if only
+    // points of fronts < k do. Equal points share a front.
+    // O(N log N) for 2 objectives (sweep), O(N log^2 N) for 3 (divide and
+    // conquer over the first objective, after Jensen), O(M N^2) beyond.
+    static std::vector<int> rank(const std::vector<double>& values, size_t m);
+
+    // Deb's O(M N^2) front peeling; the reference for rank()
+    static std::vector<int> rankNaive(const std::vector<double>& values, size_t m);
+
+    // Crowding distance of every point within its front: the normalized
+    // side lengths of the box spanned by its neighbors on each objective.
+    // The extremes of a front get infinity.
+    static std::vector<double> crowding(const std::vector<double>& values, size_t m, const std::vector<int>& ranks);
+};
@@ -0,0 +1,292 @@
+﻿#include "PathUtils.h"
+#include "NodeMarks.h"
+#include "Fitness.h"
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+static thread_local std::mt19937 rng(std::random_device{}());
+
+// Scratch reused across calls so searches don't allocate per call
+static thread_local NodeMarks searchMarks;
+static thread_local NodeMarks walkMarks;
+static thread_local std::vector<int> searchParent;
+static thread_local std::vector<int> searchParentEdge;
+static thread_local std::vector<int> bfsQueue;
+static thread_local std::vector<double> dijkstraDist;
+static thread_local std::vector<int> visibleNeighbors;
+
+bool PathUtils::isValidPath(const GraphView& g, const std::vector<int>& path) {
+    if (path.empty()) return false;
+    if (!g.hasNode(path.front())) return false;
+    if (!g.hasNode(path.back())) return false;
+
+    for (size_t i = 1; i < path.size(); ++i) {
+        int a = path[i - 1];
+        int b = path[i];
+        if (g.findEdge(a, b) < 0) return false;
+    }
+    return true;
+}
+
+bool PathUtils::isValidPath(const GraphView& g, int start, const std::vector<int>& edges) {
+    return walkEnd(g, start, edges) >= 0;
+}
+
+int PathUtils::walkEnd(const GraphView& g, int start, const std::vector<int>& edges) {
+    if (!g.hasNode(start)) return -1;
+
+    const int m = (int)g.graph.edges.size();
+    int v = start;
+    for (int e : edges) {
+        if (e < 0 || e >= m || !g.hasEdge(e)) return -1;
+        v = g.graph.across(e, v);
+        if (v < 0 || !g.hasNode(v)) return -1;
+    }
+    return v;
+}
+
+void PathUtils::toNodes(const Graph& g, int start, const std::vector<int>& edges, std::vector<int>& path) {
+    path.clear();
+    path.reserve(edges.size() + 1);
+    path.push_back(start);
+    for (int e : edges) path.push_back(g.across(e, path.back()));
+}
+
+bool PathUtils::toEdges(const GraphView& g, const std::vector<int>& path, std::vector<int>& edges) {
+    edges.clear();
+    if (path.empty()) return false;
+    edges.reserve(path.size() - 1);
+    for (size_t i = 1; i < path.size(); ++i) {
+        int e = g.findEdge(path[i - 1], path[i]);
+        if (e < 0) return false;
+        edges.push_back(e);
+    }
+    return true;
+}
+
+// Search results: the parent node and edge of every reached node, back to start
+static void traceNodes(int start, int goal, std::vector<int>& path) {
+    size_t from = path.size();
+    for (int cur = goal; ; cur = searchParent[(size_t)cur]) {
+        path.push_back(cur);
+        if (cur == start) break;
+    }
+    std::reverse(path.begin() + (std::ptrdiff_t)from, path.end());
+}
+
+static void traceEdges(int start, int goal, std::vector<int>& edges) {
+    size_t from = edges.size();
+    for (int cur = goal; cur != start; cur = searchParent[(size_t)cur]) {
+        edges.push_back(searchParentEdge[(size_t)cur]);
+    }
+    std::reverse(edges.begin() + (std::ptrdiff_t)from, edges.end());
+}
+
+// Fills the search parents from start until goal is reached; false if it isn't
+static bool bfs(const GraphView& g, int start, int goal) {
+    const size_t n = g.graph.nodes.size();
+    searchMarks.reset(n);
+    if (searchParent.size() < n) searchParent.resize(n);
+    if (searchParentEdge.size() < n) searchParentEdge.resize(n);
+    bfsQueue.clear();
+
+    bfsQueue.push_back(start);
+    searchMarks.set(start);
+    searchParent[(size_t)start] = start;
+    if (start == goal) return true;
+
+    for (size_t head = 0; head < bfsQueue.size(); ++head) {
+        int v = bfsQueue[head];
+
+        for (GraphView::Cursor c = g.cursor(v); c.next();) {
+            int to = c.target;
+            if (searchMarks.testAndSet(to)) continue;
+            searchParent[(size_t)to] = v;
+            searchParentEdge[(size_t)to] = c.edge;
+            if (to == goal) return true;
+            bfsQueue.push_back(to);
+        }
+    }
+    return false;
+}
+
+static std::vector<int> bfsNodes(const GraphView& g, int start, int goal) {
+    std::vector<int> path;
+    if (bfs(g, start, goal)) traceNodes(start, goal, path);
+    return path;
+}
+
+std::vector<int> PathUtils::bfsPath(const GraphView& g) {
+    if (!g.hasNode(g.start_node) || !g.hasNode(g.end_node)) return {};
+    return bfsNodes(g, g.start_node, g.end_node);
+}
+
+std::vector<int> PathUtils::bfsPath(const GraphView& g, int from, int to) {
+    if (!g.hasNode(from) || !g.hasNode(to)) return {};
+    return bfsNodes(g, from, to);
+}
+
+// Fills the search parents from start_node until end_node is settled, by
+// Objective's hop costs; false if it isn't
+template <class Objective>
+static bool dijkstra(const GraphView& g) {
+    int start = g.start_node;
+    int goal = g.end_node;
+    if (!g.hasNode(start) || !g.hasNode(goal)) return false;
+
+    const size_t n = g.graph.nodes.size();
+    NodeMarks& reached = searchMarks;   // dist/parent valid only where marked
+    NodeMarks& done = walkMarks;
+    reached.reset(n);
+    done.reset(n);
+    if (searchParent.size() < n) searchParent.resize(n);
+    if (searchParentEdge.size() < n) searchParentEdge.resize(n);
+    if (dijkstraDist.size() < n) dijkstraDist.resize(n);
+
+    searchParent[(size_t)start] = start;
+    if (start == goal) return true;
+
+    using Item = std::pair<double, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+
+    reached.set(start);
+    dijkstraDist[(size_t)start] = 0.0;
+    heap.emplace(0.0, start);
+
+    while (!heap.empty()) {
+        auto [d, v] = heap.top();
+        heap.pop();
+        if (done.testAndSet(v)) continue;
+        if (v == goal) break;
+
+        GraphView::Cursor c = g.cursor(v);
+        while (c.next()) {
+            int to = c.target;
+            if (done.test(to)) continue;
+            double nd = d + g.template hopCost<Objective>(c.edge);
+            if (reached.test(to) && dijkstraDist[(size_t)to] <= nd) continue;
+            reached.set(to);
+            dijkstraDist[(size_t)to] = nd;
+            searchParent[(size_t)to] = v;
+            searchParentEdge[(size_t)to] = c.edge;
+            heap.emplace(nd, to);
+        }
+    }
+    return done.test(goal);
+}
+
+template <class Objective>
+std::vector<int> PathUtils::cheapestPath(const GraphView& g) {
+    std::vector<int> path;
+    if (dijkstra<Objective>(g)) traceNodes(g.start_node, g.end_node, path);
+    return path;
+}
+
+template <class Objective>
+bool PathUtils::cheapestEdges(const GraphView& g, std::vector<int>& edges) {
+    edges.clear();
+    if (!dijkstra<Objective>(g)) return false;
+    traceEdges(g.start_node, g.end_node, edges);
+    return true;
+}
+
+#define OPTNET_INSTANTIATE_CHEAPEST(Objective, name) \
+    template std::vector<int> PathUtils::cheapestPath<Objective>(const GraphView&); \
+    template bool PathUtils::cheapestEdges<Objective>(const GraphView&, std::vector<int>&);
+OPTNET_OBJECTIVES(OPTNET_INSTANTIATE_CHEAPEST)
+#undef OPTNET_INSTANTIATE_CHEAPEST
+
+std::vector<int> PathUtils::randomPath(const GraphView& g, int maxLen) {
+    int start = g.start_node;
+    int goal = g.end_node;
+    if (!g.hasNode(start) || !g.hasNode(goal)) return {};
+
+    std::vector<int> path;
+    path.reserve((size_t)std::max(4, maxLen));
+    path.push_back(start);
+
+    NodeMarks& seen = walkMarks;
+    seen.reset(g.graph.nodes.size());
+    seen.set(start);
+
+    int cur = start;
+
+    for (int step = 0; step < maxLen; ++step) {
+        if (cur == goal) return path;
+
+        // a filtered view has to list the visible neighbors first, and a
+        // compressed row is decoded once rather than per pick
+        NeighborRange neigh = g.graph.neighbors(cur);
+        size_t degree = neigh.size();
+        const bool listed = g.filtered() || g.graph.isCompressed();
+        if (listed) {
+            visibleNeighbors.clear();
+            for (GraphView::Cursor c = g.cursor(cur); c.next();) visibleNeighbors.push_back(c.target);
+            degree = visibleNeighbors.size();
+        }
+        if (degree == 0) break;
+        auto pick = [&] {
+            size_t k = (size_t)(rng() % degree);
+            return listed ? visibleNeighbors[k] : neigh[k];
+        };
+
+        // Shuffle-like pick
+        int next = pick();
+
+        // small chance to allow revisits, but usually avoid cycles
+        bool allowRevisit = ((rng() % 100) < 10);
+        if (!allowRevisit && seen.test(next)) {
+            // try few attempts
+            bool found = false;
+            for (int t = 0; t < 5; ++t) {
+                int cand = pick();
+                if (!seen.test(cand)) { next = cand; found = true; break; }
+            }
+            if (!found) {
+                // fallback: aim toward goal via BFS from cur
+                auto tail = bfsNodes(g, cur, goal);
+                if (!tail.empty() && tail.size() >= 2) {
+                    // append tail (skip cur duplicate)
+                    for (size_t k = 1; k < tail.size(); ++k) path.push_back(tail[k]);
+                    return path;
+                }
+                // otherwise accept cycle
+            }
+        }
+
+        path.push_back(next);
+        cur = next;
+        seen.set(cur);
+
+        // if reached goal earlier
+        if (cur == goal) return path;
+    }
+
+    // Final repair attempt
+    if (repairToEnd(g, path)) return path;
+    return {};
+}
+
+bool PathUtils::repairToEnd(const GraphView& g, std::vector<int>& path) {
+    if (path.empty()) return false;
+    if (!g.hasNode(path.back()) || !g.hasNode(g.end_node)) return false;
+
+    int cur = path.back();
+    int goal = g.end_node;
+
+    auto tail = bfsNodes(g, cur, goal);
+    if (tail.empty()) return false;
+    // tail includes cur as first element
+    for (size_t i = 1; i < tail.size(); ++i) path.push_back(tail[i]);
+    return true;
+}
+
+bool PathUtils::repairToEnd(const GraphView& g, int tail, std::vector<int>& edges) {
+    if (!g.hasNode(tail) || !g.hasNode(g.end_node)) return false;
+    if (!bfs(g, tail, g.end_node)) return false;
+    traceEdges(tail, g.end_node, edges);
+    return true;
+}
@@ -0,0 +1,47 @@
+﻿#pragma once
+#include "Graph.h"
+#include "GraphView.h"
+#include "Objective.h"
+#include <vector>
+
+// All node values are dense indices (see Graph::nodes). Searches run on a
+// GraphView, so they see only its visible nodes/edges and its weights; a
+// plain Graph converts to an unfiltered view.
+namespace PathUtils {
+    bool isValidPath(const GraphView& g, const std::vector<int>& path);
+
+    // Guaranteed shortest path if exists, else {}
+    std::vector<int> bfsPath(const GraphView& g);
+    std::vector<int> bfsPath(const GraphView& g, int from, int to);
+
+    // Cheapest path by Objective::hopCost (Dijkstra) if exists, else {}.
+    // Instantiated for each of OPTNET_OBJECTIVES.
+    template <class Objective = DefaultObjective>
+    std::vector<int> cheapestPath(const GraphView& g);
+
+    // Random walk that tries to reach end; uses adjacency; may fail -> {}
+    std::vector<int> randomPath(const GraphView& g, int maxLen);
+
+    // Repair a partial path so it ends at end_node if possible
+    bool repairToEnd(const GraphView& g, std::vector<int>& path);
+
+    // Edge genome forms (Individual.h): a path is a start node and the edge
+    // ids walked from it
+    bool isValidPath(const GraphView& g, int start, const std::vector<int>& edges);
+
+    // Last node of the walk, -1 if an edge is hidden or doesn't continue it
+    int walkEnd(const GraphView& g, int start, const std::vector<int>& edges);
+
+    // Node sequence of a valid walk
+    void toNodes(const Graph& g, int start, const std::vector<int>& edges, std::vector<int>& path);
+
+    // Edge ids of a node path (findEdge per hop); false if a hop has no edge
+    bool toEdges(const GraphView& g, const std::vector<int>& path, std::vector<int>& edges);
+
+    // cheapestPath as edge ids from start_node; false if there is no path
+    template <class Objective = DefaultObjective>
+    bool cheapestEdges(const GraphView& g, std::vector<int>& edges);
+
+    // Appends the edges of a shortest path from tail (where the walk ends) to end_node
+    bool repairToEnd(const GraphView& g, int tail, std::vector<int>& edges);
+}
@@ -0,0 +1,47 @@
+﻿#include "QuantizedWeights.h"
+#include "Graph.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+QuantizedColumn QuantizedColumn::encode(const double* values, size_t count) {
+    QuantizedColumn c;
+    c.q.resize(count);
+    if (count == 0) return c;
+
+    double lo = *std::min_element(values, values + count);
+    double hi = *std::max_element(values, values + count);
+    c.offset = lo;
+    c.step = hi > lo ? (hi - lo) / 65535.0 : 1.0;
+
+    for (size_t i = 0; i < count; ++i) {
+        double q = std::round((values[i] - lo) / c.step);
+        c.q[i] = (uint16_t)std::min(65535.0, std::max(0.0, q));
+    }
+
+    double smallest = std::min(std::fabs(lo), std::fabs(hi));
+    if (lo < 0.0 && hi > 0.0) smallest = 0.0;
+    c.maxRelError = hi > lo
+        ? (smallest > 0.0 ? c.step / (2.0 * smallest) : std::numeric_limits<double>::infinity())
+        : 0.0;
+    return c;
+}
+
+QuantizedWeights QuantizedWeights::fromEdges(const EdgeList& edges) {
+    const size_t m = edges.size();
+    std::vector<double> lat(m);
+    std::vector<double> bw(m);
+    std::vector<double> pen(m);
+    for (size_t id = 0; id < m; ++id) {
+        lat[id] = (double)edges.latency[id];
+        bw[id] = (double)edges.bandwidth[id];
+        pen[id] = std::max(0.001, lat[id]) / std::max(0.001, bw[id]);
+    }
+
+    QuantizedWeights w;
+    w.latency = QuantizedColumn::encode(lat.data(), m);
+    w.bandwidth = QuantizedColumn::encode(bw.data(), m);
+    w.penalty = QuantizedColumn::encode(pen.data(), m);
+    return w;
+}
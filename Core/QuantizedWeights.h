@@ -0,0 +1,44 @@
+﻿#pragma once
+#include "AlignedAllocator.h"
+#include <cstddef>
+#include <cstdint>
+
+struct EdgeList;
+
+// One weight column as 16-bit fixed point: value = offset + q * step, with
+// offset/step fitted to the column's range. Rounding keeps the absolute
+// error within step / 2, so the relative error of any value is at most
+// step / (2 * smallest value), computed per column as maxRelError.
+class QuantizedColumn {
+public:
+    static QuantizedColumn encode(const double* values, size_t count);
+
+    double operator[](size_t i) const { return offset + step * (double)q[i]; }
+    size_t size() const { return q.size(); }
+    size_t bytes() const { return q.size() * sizeof(uint16_t); }
+
+    double maxRelError = 0.0;
+
+private:
+    double offset = 0.0;
+    double step = 1.0;
+    AlignedVector<uint16_t> q;
+};
+
+// Compact copy of the edge weights for the traversal and fitness kernels:
+// latency, bandwidth and the per-hop penalty lat/bw (both clamped to 0.001
+// as in Fitness), 2 bytes each instead of 8, so a cache line holds 32 edges.
+//
+// Error bound: generator weights (latency [1,11], bandwidth [1,10], penalty
+// [0.1,11]) come out within ~8e-5, ~7e-5 and ~8e-4 relative error; a path
+// score's latency and bandwidth terms inherit the largest of these.
+class QuantizedWeights {
+public:
+    static QuantizedWeights fromEdges(const EdgeList& edges);
+
+    QuantizedColumn latency;
+    QuantizedColumn bandwidth;
+    QuantizedColumn penalty;
+
+    size_t bytes() const { return latency.bytes() + bandwidth.bytes() + penalty.bytes(); }
+};
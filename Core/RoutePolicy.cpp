@@ -0,0 +1,57 @@
+﻿#include "RoutePolicy.h"
+#include <stdexcept>
+
+unsigned RoutePolicy::parseTypes(const std::string& names) {
+    static const char* const known[] = { "PC", "COMPUTE", "SERVER", "STORAGE", "GATEWAY" };
+    unsigned bits = 0;
+    size_t from = 0;
+    while (from <= names.size()) {
+        size_t to = names.find(',', from);
+        if (to == std::string::npos) to = names.size();
+        std::string name = names.substr(from, to - from);
+        if (!name.empty()) {
+            int t = 0;
+            while (t < NODE_TYPE_COUNT - 1 && name != known[t]) ++t;
+            if (t == NODE_TYPE_COUNT - 1) throw std::runtime_error("RoutePolicy: unknown node type " + name);
+            bits |= typeBit((NodeType)t);
+        }
+        from = to + 1;
+    }
+    return bits;
+}
+
+RouteCheck::RouteCheck(const Graph& g, const RoutePolicy& p) : graph(&g), policy(p) {
+    if (!g.types) throw std::runtime_error("RouteCheck: graph has no node type index");
+    blocked = g.types->mask(p.forbidden);
+    wanted = g.types->mask(p.required);
+}
+
+static int countMissing(unsigned required, unsigned seen) {
+    int count = 0;
+    for (unsigned left = required & ~seen; left; left &= left - 1) ++count;
+    return count;
+}
+
+int RouteCheck::missing(const std::vector<int>& path) const {
+    if (!active()) return 0;
+
+    unsigned seen = 0;
+    for (int v : path) {
+        if (blocked.test(v)) return -1;
+        if (wanted.test(v)) seen |= typeBit(graph->nodes[(size_t)v].type);
+    }
+    return countMissing(policy.required, seen);
+}
+
+int RouteCheck::missing(int start, const std::vector<int>& edges) const {
+    if (!active()) return 0;
+
+    unsigned seen = 0;
+    int v = start;
+    for (size_t k = 0;; v = graph->across(edges[k++], v)) {
+        if (blocked.test(v)) return -1;
+        if (wanted.test(v)) seen |= typeBit(graph->nodes[(size_t)v].type);
+        if (k == edges.size()) break;
+    }
+    return countMissing(policy.required, seen);
+}
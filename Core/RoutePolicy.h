@@ -0,0 +1,43 @@
+﻿#pragma once
+#include "Graph.h"
+#include "NodeTypeIndex.h"
+#include <string>
+#include <vector>
+
+// Node-type constraints on a route, as typeBit() masks
+struct RoutePolicy {
+    unsigned required = 0;    // each of these types must appear on the path
+    unsigned forbidden = 0;   // no path node may have one of these types
+
+    bool empty() const { return required == 0 && forbidden == 0; }
+
+    // typeBit() mask of a comma-separated list of type names ("SERVER,PC");
+    // throws std::runtime_error on an unknown name
+    static unsigned parseTypes(const std::string& names);
+};
+
+// A RoutePolicy bound to one graph. The forbidden types are merged into a
+// single bitmap, so checking a node is one bit test.
+class RouteCheck {
+public:
+    RouteCheck() = default;
+    RouteCheck(const Graph& g, const RoutePolicy& policy);
+
+    bool active() const { return !policy.empty(); }
+    bool allowed(int v) const { return !blocked.test(v); }
+
+    // How many required types the path lacks; -1 if it hits a forbidden node
+    int missing(const std::vector<int>& path) const;
+    int missing(int start, const std::vector<int>& edges) const;   // edge genome
+
+    // What the policy adds to a score, given missing(): MISSING_TYPE_PENALTY
+    // per required type the path lacks, 1e18 through a forbidden node
+    static constexpr double MISSING_TYPE_PENALTY = 1000.0;
+    static double penalty(int missing) { return missing < 0 ? 1e18 : MISSING_TYPE_PENALTY * missing; }
+
+private:
+    const Graph* graph = nullptr;
+    RoutePolicy policy;
+    NodeBitmap blocked;
+    NodeBitmap wanted;   // nodes of any required type
+};
@@ -1,7 +0,0 @@
-﻿#pragma once
-#include <vector>
-
-struct Individual {
-    std::vector<int> path;
-    double fitness = 1e18;
-};
@@ -1,24 +1,60 @@
 ﻿#include "GraphLoader.h"
+#include "GraphPruner.h"
+#include "GraphContractor.h"
+#include "Fitness.h"
 #include "GA.h"
 #include "JsonExporter.h"
 
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
-int main() {
+// Usage: GA [--contract] [--require=TYPES] [--forbid=TYPES]
+// --contract folds degree-2 chains into super-edges before the search; the
+// search is faster there but its score only approximates the real one
+// (see GraphContractor). --require and --forbid set a route policy
+// (RoutePolicy.h) from comma-separated node type names, e.g. --forbid=GATEWAY.
+int main(int argc, char** argv) {
     const std::string inPath = "D:/OptNet/results/input_graph.json";
     const std::string outPath = "D:/OptNet/results/best_path.json";
 
     try {
+        bool contract = false;
+        RoutePolicy policy;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--contract") contract = true;
+            else if (arg.rfind("--require=", 0) == 0) policy.required |= RoutePolicy::parseTypes(arg.substr(10));
+            else if (arg.rfind("--forbid=", 0) == 0) policy.forbidden |= RoutePolicy::parseTypes(arg.substr(9));
+            else throw std::runtime_error("unknown option " + arg);
+        }
+
         std::cout << "[MAIN] Loading graph from: " << inPath << "\n";
         Graph g = GraphLoader::loadFromFile(inPath);
 
+        // solve on the nodes that can lie on a start->end route only
+        PrunedGraph pruned = GraphPruner::prune(g);
+        ContractedGraph work;
+        if (contract) {
+            work = GraphContractor::contract(pruned.graph, policy.required | policy.forbidden);
+            work.remapSource(pruned.origin);
+        }
+
         std::cout << "[MAIN] Running GA...\n";
-        GA ga(g);
+        GA ga(contract ? work.graph : pruned.graph);
+        ga.setRoutePolicy(policy);
         Individual best = ga.run();
+        std::vector<int> path = contract ? work.expand(best.path) : pruned.toSource(best.path);
+
+        // scored on the source graph with the policy's penalty, as the GA scores it
+        int missing = RouteCheck(g, policy).missing(path);
+        double fitness = Fitness::evaluate(g, path) + RouteCheck::penalty(missing);
+        if (missing != 0)
+            std::cerr << "[MAIN] WARNING: best path breaks the route policy (missing required types: " << missing << ")\n";
 
         std::cout << "[MAIN] Saving best path to: " << outPath << "\n";
-        JsonExporter::exportPath(best.path, best.fitness, outPath);
+        JsonExporter::exportPath(g, path, fitness, outPath);
 
         std::cout << "[MAIN] Done.\n";
         return 0;
@@ -1,8 +0,0 @@
-﻿#pragma once
-
-struct Edge {
-    int node_a = -1;
-    int node_b = -1;
-    double latency = 1.0;
-    double bandwidth = 1.0;
-};
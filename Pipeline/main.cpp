@@ -0,0 +1,115 @@
+﻿#include "GraphGenerator.h"
+#include "GraphPruner.h"
+#include "GraphReplicas.h"
+#include "GraphContractor.h"
+#include "JsonExporter.h"
+#include "ObjectiveRegistry.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Usage: OptNet [nodes] [runs] [single|blocks|pareto] [objective] [--contract]
+//               [--require=TYPES] [--forbid=TYPES] [--no-replicas]
+// Generates `runs` graphs and optimizes each one in memory. The last graph
+// and its best path are written for the web viewer. With "blocks", every
+// biconnected block on the route is solved separately, in parallel. With
+// "pareto", one multi-objective run lists the Pareto front over latency,
+// bandwidth and hops; the member the objective scores best is written.
+// objective names one of ObjectiveRegistry (default: "default").
+// --contract folds degree-2 chains into super-edges before the search, which
+// then only approximates the score (see GraphContractor); not with "pareto",
+// whose front must compare the criteria of the real routes.
+// --require=TYPES and --forbid=TYPES set a route policy (RoutePolicy.h) from
+// comma-separated node type names, e.g. --forbid=GATEWAY; not with "blocks".
+// --no-replicas keeps the "blocks" workers on the shared block graphs instead
+// of NUMA-local copies (Numa::setLocalReplicas).
+int main(int argc, char** argv) {
+    const std::string graphPath = "D:/OptNet/results/input_graph.json";
+    const std::string pathPath = "D:/OptNet/results/best_path.json";
+
+    try {
+        std::vector<std::string> args;
+        bool contract = false;
+        RoutePolicy policy;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--contract") contract = true;
+            else if (arg == "--no-replicas") Numa::setLocalReplicas(false);
+            else if (arg.rfind("--require=", 0) == 0) policy.required |= RoutePolicy::parseTypes(arg.substr(10));
+            else if (arg.rfind("--forbid=", 0) == 0) policy.forbidden |= RoutePolicy::parseTypes(arg.substr(9));
+            else if (arg.rfind("--", 0) == 0) throw std::runtime_error("unknown option " + arg);
+            else args.push_back(arg);
+        }
+
+        int nodes = args.size() > 0 ? std::stoi(args[0]) : 40;
+        int runs = args.size() > 1 ? std::stoi(args[1]) : 1;
+        std::string mode = args.size() > 2 ? args[2] : "single";
+        if (mode != "single" && mode != "blocks" && mode != "pareto")
+            throw std::runtime_error("mode must be single, blocks or pareto");
+        if (nodes < 2 || runs < 1) throw std::runtime_error("nodes must be >= 2 and runs >= 1");
+        if (mode == "blocks" && !policy.empty()) throw std::runtime_error("blocks mode takes no route policy");
+        if (mode == "pareto" && contract) throw std::runtime_error("pareto mode takes no --contract");
+        const ObjectiveEntry& objective = ObjectiveRegistry::find(args.size() > 3 ? args[3] : "default");
+        std::cout << "[MAIN] Objective: " << objective.name << "\n";
+
+        GraphGenerator gen;
+        Graph g;
+        Individual best;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int run = 0; run < runs; ++run) {
+            std::cout << "[MAIN] Run " << (run + 1) << "/" << runs << "\n";
+            g = gen.generate(nodes);
+            PrunedGraph pruned = GraphPruner::prune(g);
+            ContractedGraph work;
+            if (contract) {
+                work = GraphContractor::contract(pruned.graph, policy.required | policy.forbidden);
+                work.remapSource(pruned.origin);
+            }
+            const Graph& solveOn = contract ? work.graph : pruned.graph;
+            auto toSource = [&](const std::vector<int>& path) {
+                return contract ? work.expand(path) : pruned.toSource(path);
+            };
+            // scored on the source graph with the policy's penalty, as the GA scores it
+            RouteCheck route(g, policy);
+            auto exportScore = [&](const std::vector<int>& path) {
+                return objective.evaluate(g, path) + RouteCheck::penalty(route.missing(path));
+            };
+
+            if (mode == "pareto") {
+                best = Individual();
+                for (auto& ind : objective.runPareto(solveOn, policy)) {
+                    ind.path = toSource(ind.path);
+                    ind.fitness = exportScore(ind.path);
+                    std::cout << "[MAIN] Front: latency=" << ind.criteria[0] << " bandwidth=" << ind.criteria[1]
+                        << " hops=" << ind.criteria[2] << " fitness=" << ind.fitness << "\n";
+                    if (ind.fitness < best.fitness) best = std::move(ind);
+                }
+                if (best.path.empty()) best.path = { g.start_node };
+                continue;
+            }
+
+            best = mode == "blocks" ? objective.runByBlocks(solveOn, true) : objective.run(solveOn, policy);
+            best.path = toSource(best.path);
+            best.fitness = exportScore(best.path);
+        }
+        if (int missing = RouteCheck(g, policy).missing(best.path))
+            std::cerr << "[MAIN] WARNING: best path breaks the route policy (missing required types: " << missing << ")\n";
+        auto t1 = std::chrono::steady_clock::now();
+
+        std::cout << "[MAIN] " << runs << " run(s) in "
+            << std::chrono::duration<double>(t1 - t0).count() << " s\n";
+
+        JsonExporter::exportGraph(g, graphPath);
+        JsonExporter::exportPath(g, best.path, best.fitness, pathPath);
+
+        std::cout << "[MAIN] Done.\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[MAIN] ERROR: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,21 @@
+﻿#pragma once
+#include <atomic>
+#include <iostream>
+
+// Assertions for the test executables. A failed CHECK prints where and
+// what, and main returns Check::failures() so ctest sees a non-zero exit.
+// Safe to use from several threads.
+namespace Check {
+    inline std::atomic<int>& failures() {
+        static std::atomic<int> count{ 0 };
+        return count;
+    }
+}
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            ++Check::failures(); \
+            std::cerr << "[TEST] " << __FILE__ << ":" << __LINE__ << " failed: " #cond "\n"; \
+        } \
+    } while (0)
@@ -0,0 +1,132 @@
+﻿#include "Check.h"
+#include "Fitness.h"
+#include "GraphGenerator.h"
+#include "PathUtils.h"
+
+#include <random>
+#include <vector>
+
+// The precomputed hop terms must give bit for bit the score of the formula
+// on the raw weight columns (evaluateExact), for every objective and every
+// scoring form: node paths, edge genomes, running sums and each batch
+// kernel. Paths include revisits, and some edges get weights under the
+// clamps or are rewritten after the build.
+static const int NODES = 1500;
+static const int PATHS = 600;
+
+struct Sample {
+    std::vector<int> path;
+    std::vector<int> edges;
+};
+
+static std::vector<Sample> samples(const Graph& g, std::mt19937& rng) {
+    std::vector<Sample> out;
+    while ((int)out.size() < PATHS) {
+        Sample s;
+        s.path = PathUtils::randomPath(g, 60);
+        if (s.path.size() < 2) continue;
+
+        // every other path walks one hop back and forth somewhere on the way
+        if (out.size() % 2) {
+            size_t k = rng() % (s.path.size() - 1);
+            int a = s.path[k], b = s.path[k + 1];
+            s.path.insert(s.path.begin() + (long)k + 1, { b, a });
+        }
+        if (!PathUtils::toEdges(g, s.path, s.edges)) continue;
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+template <class Objective>
+static void checkObjective(const Graph& g, const std::vector<Sample>& all) {
+    using F = BasicFitness<Objective>;
+
+    PathBatch batch;
+    for (const auto& s : all) {
+        double exact = F::evaluateExact(g, s.path);
+        CHECK(F::evaluate(g, s.path) == exact);
+        CHECK(F::evaluate(g, s.path.front(), s.edges) == exact);
+        CHECK(F::evaluateExact(g, s.path.front(), s.edges) == exact);
+
+        PathSums sums;
+        CHECK(F::walkSums(g, s.path.front(), s.edges, sums));
+        CHECK(F::evaluate(g, sums) == exact);
+
+        batch.add(s.path.front(), s.edges);
+    }
+
+    for (BatchKernel kernel : { BatchKernel::Scalar, BatchKernel::AVX2, BatchKernel::AVX512 }) {
+        std::vector<double> scores;
+        F::evaluateBatch(g, batch, scores, kernel);
+        CHECK(scores.size() == all.size());
+        for (size_t i = 0; i < all.size() && i < scores.size(); ++i)
+            CHECK(scores[i] == F::evaluateExact(g, all[i].path));
+    }
+
+    // bounded: never rejects a walk within the cutoff, scores it as in full
+    for (const auto& s : all) {
+        double full = F::evaluate(g, s.path.front(), s.edges);
+        CHECK(F::evaluateBounded(g, s.path.front(), s.edges, full) == full);
+        double tight = F::evaluateBounded(g, s.path.front(), s.edges, full * 0.5 - 1.0);
+        CHECK(tight == F::REJECTED || tight == full);
+    }
+
+    // a walk that stops short of end_node is invalid in every form, also
+    // when a bounded walk could reject it first
+    for (const auto& s : all) {
+        if (s.path.size() < 3) continue;
+        std::vector<int> cut(s.path.begin(), s.path.end() - 1);
+        if (cut.back() == g.end_node) continue;
+        std::vector<int> edges(s.edges.begin(), s.edges.end() - 1);
+        CHECK(F::evaluateExact(g, cut) == 1e18);
+        CHECK(F::evaluate(g, cut) == 1e18);
+        CHECK(F::evaluate(g, cut.front(), edges) == 1e18);
+        CHECK(F::evaluateBounded(g, cut.front(), edges, -1e18) == 1e18);
+
+        std::vector<int> broken = s.edges;
+        broken.back() = -1;
+        CHECK(F::evaluateBounded(g, s.path.front(), broken, -1e18) == 1e18);
+        break;
+    }
+
+    // the cheapest path is searched on this objective's own hop costs: no
+    // sampled walk, nor the default objective's cheapest path, is cheaper
+    GraphView view(g);
+    auto cost = [&](const std::vector<int>& edges) {
+        double sum = 0.0;
+        for (int e : edges) sum += view.hopCost<Objective>(e);
+        return sum;
+    };
+    std::vector<int> cheapest, fallback;
+    CHECK(PathUtils::cheapestEdges<Objective>(view, cheapest));
+    CHECK(PathUtils::cheapestEdges<DefaultObjective>(view, fallback));
+    double best = cost(cheapest);
+    CHECK(best <= cost(fallback) * (1 + 1e-12));
+    for (const auto& s : all)
+        if (s.path.front() == g.start_node) CHECK(best <= cost(s.edges) * (1 + 1e-12));
+}
+
+static void checkAll(const Graph& g, const std::vector<Sample>& all) {
+#define OPTNET_CHECK_OBJECTIVE(Objective, name) checkObjective<Objective>(g, all);
+    OPTNET_OBJECTIVES(OPTNET_CHECK_OBJECTIVE)
+#undef OPTNET_CHECK_OBJECTIVE
+}
+
+int main() {
+    std::mt19937 rng(1);
+    Graph g = GraphGenerator().generate(NODES);
+    std::vector<Sample> all = samples(g, rng);
+    checkAll(g, all);
+
+    // weights under the clamps, and updates after the build, must refresh
+    // the hop terms the same way the formula sees them
+    for (size_t id = 0; id < g.edges.size(); id += 5) {
+        double latency = id % 2 ? 0.0001 : 37.5 + (double)(rng() % 1000) / 7.0;
+        double bandwidth = id % 3 ? 0.0 : 0.3 + (double)(rng() % 1000) / 3.0;
+        g.setEdgeWeights((int)id, latency, bandwidth);
+    }
+    checkAll(g, all);
+
+    return Check::failures() ? 1 : 0;
+}
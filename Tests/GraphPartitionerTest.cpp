@@ -0,0 +1,91 @@
+﻿#include "Check.h"
+#include "GraphPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Partitions side x side grids. Every part must stay within the imbalance
+// bound, the reported cut must equal a recount over the edges, the member
+// and boundary lists must agree with part[], and the cut must stay near
+// that of a straight-line block layout.
+static Graph grid(int side) {
+    Graph g;
+    for (int i = 0; i < side * side; ++i) {
+        Node node;
+        node.id = i;
+        g.nodes.push_back(node);
+    }
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side) g.edges.push_back({ v, v + 1, 1.0, 1.0 });
+            if (r + 1 < side) g.edges.push_back({ v, v + side, 1.0, 1.0 });
+        }
+    }
+    g.start_node = 0;
+    g.end_node = side * side - 1;
+    g.buildAdjacency();
+    return g;
+}
+
+static void checkPartition(const Graph& g, int side, int parts) {
+    PartitionOptions options;
+    options.parts = parts;
+    Partition p = GraphPartitioner::partition(g, options);
+    int n = g.nodeCount();
+
+    CHECK(p.parts == parts);
+    CHECK((int)p.part.size() == n);
+
+    // balance: the +1 per bisection level covers rounding of the targets
+    int levels = 0;
+    while ((1 << levels) < parts) ++levels;
+    double bound = (1.0 + options.imbalance) * n / parts + levels;
+    std::vector<int> size((size_t)parts, 0);
+    for (int v = 0; v < n; ++v) {
+        CHECK(p.part[(size_t)v] >= 0 && p.part[(size_t)v] < parts);
+        ++size[(size_t)p.part[(size_t)v]];
+    }
+    for (int s : size) CHECK(s > 0 && s <= bound);
+
+    // cut and boundary recounted from part[]
+    long long cut = 0;
+    std::vector<char> onBoundary((size_t)n, 0);
+    for (size_t e = 0; e < g.edges.size(); ++e) {
+        int a = g.edges.node_a[e], b = g.edges.node_b[e];
+        if (p.part[(size_t)a] != p.part[(size_t)b]) {
+            ++cut;
+            onBoundary[(size_t)a] = onBoundary[(size_t)b] = 1;
+        }
+    }
+    CHECK(p.cut == cut);
+
+    for (int q = 0; q < parts; ++q) {
+        NodeSpan members = p.nodesOf(q);
+        CHECK((int)members.size() == size[(size_t)q]);
+        CHECK(std::is_sorted(members.begin(), members.end()));
+        for (int v : members) CHECK(p.part[(size_t)v] == q);
+
+        NodeSpan boundary = p.boundaryOf(q);
+        CHECK(std::is_sorted(boundary.begin(), boundary.end()));
+        size_t expected = 0;
+        for (int v : members) expected += onBoundary[(size_t)v];
+        CHECK(boundary.size() == expected);
+        for (int v : boundary) CHECK(p.part[(size_t)v] == q && onBoundary[(size_t)v]);
+    }
+
+    // quality: a rows x cols layout of blocks cuts side * (rows + cols - 2)
+    // edges (side for a bisection); multilevel FM should stay within twice that
+    int rows = std::max(1, (int)std::lround(std::sqrt((double)parts)));
+    int cols = (parts + rows - 1) / rows;
+    long long blocks = (long long)side * (rows + cols - 2);
+    CHECK(cut <= 2 * blocks);
+}
+
+int main() {
+    Graph g = grid(100);
+    for (int parts : { 2, 3, 4, 5, 8, 16 }) checkPartition(g, 100, parts);
+    checkPartition(grid(37), 37, 6);
+    return Check::failures() ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+﻿#include "Check.h"
+#include "Fitness.h"
+#include "GA.h"
+#include "GraphGenerator.h"
+#include "GraphStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Readers pin snapshots while a writer publishes setEdgeWeights updates.
+// Version v rewrites the edges with id % STRIDE == v % STRIDE to latency v
+// and bandwidth 2v, so the weights every version must hold follow from its
+// number alone. A pinned snapshot has to match its version on every check,
+// however many versions are published in between.
+static const int VERSIONS = 400;
+static const int STRIDE = 7;
+static const int READERS = 4;
+
+// The version that last wrote edge id as of version v, 0 if none did
+static int lastWriter(size_t id, int v) {
+    int w = v - (int)(((size_t)v + STRIDE - id % STRIDE) % STRIDE);
+    return w >= 1 ? w : 0;
+}
+
+static std::vector<EdgeUpdate> updatesFor(const Graph& g, int v) {
+    std::vector<EdgeUpdate> updates;
+    for (size_t id = (size_t)(v % STRIDE); id < g.edges.size(); id += STRIDE)
+        updates.push_back({ (int)id, (double)v, 2.0 * v });
+    return updates;
+}
+
+// Every weight and derived hop term of the snapshot matches its version
+static bool consistent(const Graph& g, const Graph& initial) {
+    int v = (int)g.version;
+    for (size_t id = 0; id < g.edges.size(); ++id) {
+        int w = lastWriter(id, v);
+        double lat = w ? (double)w : (double)initial.edges.latency[id];
+        double bw = w ? 2.0 * w : (double)initial.edges.bandwidth[id];
+        if ((double)g.edges.latency[id] != lat || (double)g.edges.bandwidth[id] != bw) return false;
+
+        HopTerms hop = g.hop(id);
+        if (hop.latency != std::max(0.001, lat) || hop.penalty != std::max(0.001, lat) / std::max(0.001, bw)) return false;
+        if (g.cost(id) != Fitness::hopCost(lat, bw)) return false;
+    }
+    return true;
+}
+
+int main() {
+    Graph initial = GraphGenerator().generate(300);
+    GraphStore store(initial);
+    std::shared_ptr<const Graph> first = store.pin();
+
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&] {
+            unsigned long long last = 0;
+            while (!done) {
+                std::shared_ptr<const Graph> snap = store.pin();
+                CHECK(snap->version >= last);
+                last = snap->version;
+                CHECK(consistent(*snap, initial));
+                std::this_thread::yield();
+                CHECK(consistent(*snap, initial));
+            }
+        });
+    }
+
+    // a GA on a pinned snapshot scores against that version throughout
+    std::thread solver([&] {
+        std::shared_ptr<const Graph> snap = store.pin();
+        Individual best = GA(snap).run();
+        CHECK(consistent(*snap, initial));
+        if (best.fitness < 1e17) CHECK(best.fitness == Fitness::evaluate(*snap, best.path));
+    });
+
+    for (int v = 1; v <= VERSIONS; ++v) {
+        CHECK(store.publish(updatesFor(initial, v)) == (unsigned long long)v);
+    }
+    solver.join();
+    done = true;
+    for (auto& t : readers) t.join();
+
+    CHECK(store.version() == (unsigned long long)VERSIONS);
+    CHECK(consistent(*store.pin(), initial));
+    CHECK(first->version == 0 && consistent(*first, initial));
+
+    return Check::failures() ? 1 : 0;
+}
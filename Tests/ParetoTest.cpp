@@ -0,0 +1,108 @@
+﻿#include "Check.h"
+#include "Pareto.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+// ParetoSort::rank (sweep for 2 objectives, divide and conquer for 3, peeling
+// beyond) against Deb's rankNaive, on point sets full of ties: half the
+// points sit on a coarse grid, some repeat earlier points exactly, and some
+// sets are all one point. Crowding must give the extremes of every front
+// infinity on every objective and everything else a finite distance.
+static std::vector<double> points(size_t n, size_t m, std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> values(n * m);
+    for (size_t i = 0; i < n; ++i) {
+        // every fifth point repeats an earlier one
+        if (i > 0 && i % 5 == 0) {
+            size_t from = rng() % i;
+            std::copy(values.begin() + (long)(from * m), values.begin() + (long)(from * m + m), values.begin() + (long)(i * m));
+            continue;
+        }
+        for (size_t j = 0; j < m; ++j) {
+            double v = unit(rng);
+            values[i * m + j] = i % 2 ? std::floor(v * 4.0) : v;
+        }
+    }
+    return values;
+}
+
+static void checkCrowding(const std::vector<double>& values, size_t m, const std::vector<int>& ranks) {
+    std::vector<double> distance = ParetoSort::crowding(values, m, ranks);
+    CHECK(distance.size() == ranks.size());
+    if (ranks.empty()) return;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    int fronts = *std::max_element(ranks.begin(), ranks.end()) + 1;
+    for (int f = 0; f < fronts; ++f) {
+        std::vector<size_t> front;
+        for (size_t i = 0; i < ranks.size(); ++i) {
+            if (ranks[i] == f) front.push_back(i);
+        }
+        if (front.empty()) continue;
+        if (front.size() <= 2) {
+            for (size_t i : front) CHECK(distance[i] == inf);
+            continue;
+        }
+        for (size_t i : front) CHECK(distance[i] >= 0.0);
+
+        // some point at the least and some at the greatest value of every
+        // objective is an extreme; ties may put the others inside
+        for (size_t j = 0; j < m; ++j) {
+            auto value = [&](size_t i) { return values[i * m + j]; };
+            auto byValue = [&](size_t a, size_t b) { return value(a) < value(b); };
+            double lo = value(*std::min_element(front.begin(), front.end(), byValue));
+            double hi = value(*std::max_element(front.begin(), front.end(), byValue));
+            bool loInf = false, hiInf = false;
+            for (size_t i : front) {
+                if (value(i) == lo && distance[i] == inf) loInf = true;
+                if (value(i) == hi && distance[i] == inf) hiInf = true;
+            }
+            CHECK(loInf && hiInf);
+        }
+
+        // a point strictly inside on every objective is no extreme
+        for (size_t i : front) {
+            bool inside = true;
+            for (size_t j = 0; j < m && inside; ++j) {
+                bool below = false, above = false;
+                for (size_t k : front) {
+                    below |= values[k * m + j] < values[i * m + j];
+                    above |= values[k * m + j] > values[i * m + j];
+                }
+                inside = below && above;
+            }
+            if (inside) CHECK(distance[i] < inf);
+        }
+    }
+}
+
+static void checkSet(const std::vector<double>& values, size_t m) {
+    std::vector<int> fast = ParetoSort::rank(values, m);
+    std::vector<int> naive = ParetoSort::rankNaive(values, m);
+    CHECK(fast == naive);
+    checkCrowding(values, m, fast);
+}
+
+int main() {
+    std::mt19937 rng(1);
+    for (size_t m : { 2, 3, 4 }) {
+        for (size_t n : { 0, 1, 2, 3, 17, 200, 1500 }) checkSet(points(n, m, rng), m);
+
+        // all one point: a single front, every member an extreme
+        std::vector<double> same(40 * m, 0.5);
+        checkSet(same, m);
+        CHECK(ParetoSort::rank(same, m) == std::vector<int>(40, 0));
+
+        // a chain where each point dominates the next: one front per point
+        std::vector<double> chain(30 * m);
+        for (size_t i = 0; i < 30; ++i)
+            for (size_t j = 0; j < m; ++j) chain[i * m + j] = (double)i;
+        std::vector<int> ranks = ParetoSort::rank(chain, m);
+        for (size_t i = 0; i < 30; ++i) CHECK(ranks[i] == (int)i);
+    }
+    return Check::failures() ? 1 : 0;
+}
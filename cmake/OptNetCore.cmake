@@ -0,0 +1,5 @@
+﻿# The optnet_core library every executable links. The top-level build adds
+# it once; a single folder configured on its own adds it here.
+if (NOT TARGET optnet_core)
+    add_subdirectory(${CMAKE_CURRENT_LIST_DIR}/../Core ${CMAKE_BINARY_DIR}/optnet_core)
+endif()